@@ -0,0 +1,173 @@
+// metrics.cpp
+#include "metrics.h"
+#include <mutex>
+#include <algorithm>
+#include <sstream>
+
+namespace {
+
+struct MetricInfo {
+    std::string name, help;
+};
+
+// Everything shared: metric names and every thread block ever handed out.
+// Blocks are never freed; a block whose thread has exited goes on the free
+// list and is reused by the next new thread, its counts carrying on.
+struct Registry {
+    std::mutex lock;
+    std::vector<MetricInfo> counters;
+    std::vector<MetricInfo> histograms;
+    std::vector<MetricThreadBlock*> blocks;
+    std::vector<MetricThreadBlock*> freeBlocks;
+};
+
+Registry& registry() {
+    static Registry* r = new Registry();   // outlives every static MetricCounter
+    return *r;
+}
+
+int registerMetric(std::vector<MetricInfo>& list, int limit, const char* name, const char* help) {
+    std::lock_guard<std::mutex> guard(registry().lock);
+    MetricInfo info;
+    info.name = name;
+    info.help = help;
+    list.push_back(info);
+    int id = static_cast<int>(list.size()) - 1;
+    return id < limit ? id : limit;
+}
+
+// Hands the block back when its thread exits
+struct BlockReleaser {
+    MetricThreadBlock* block = nullptr;
+    ~BlockReleaser() {
+        if (!block) return;
+        Registry& r = registry();
+        std::lock_guard<std::mutex> guard(r.lock);
+        r.freeBlocks.push_back(block);
+    }
+};
+
+uint64_t load(const std::atomic<uint64_t>& cell) {
+    return cell.load(std::memory_order_relaxed);
+}
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+} // namespace
+
+MetricThreadBlock* attachMetricThread() {
+    static thread_local BlockReleaser releaser;
+    Registry& r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    MetricThreadBlock* block;
+    if (!r.freeBlocks.empty()) {
+        block = r.freeBlocks.back();
+        r.freeBlocks.pop_back();
+    } else {
+        block = new MetricThreadBlock();   // value-initialised: all cells zero
+        r.blocks.push_back(block);
+    }
+    releaser.block = block;
+    return block;
+}
+
+MetricCounter::MetricCounter(const char* name, const char* help)
+    : id(registerMetric(registry().counters, kMaxCounters, name, help)) {}
+
+MetricHistogram::MetricHistogram(const char* name, const char* help)
+    : id(registerMetric(registry().histograms, kMaxHistograms, name, help)) {}
+
+MetricsSnapshot Metrics::snapshot() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    MetricsSnapshot snap;
+
+    int counters = std::min<int>(r.counters.size(), kMaxCounters);
+    for (int i = 0; i < counters; ++i) {
+        MetricsSnapshot::Counter c;
+        c.name = r.counters[i].name;
+        c.help = r.counters[i].help;
+        c.value = 0;
+        for (MetricThreadBlock* b : r.blocks) c.value += load(b->counters[i]);
+        snap.counters.push_back(c);
+    }
+
+    int histograms = std::min<int>(r.histograms.size(), kMaxHistograms);
+    for (int i = 0; i < histograms; ++i) {
+        MetricsSnapshot::Histogram h;
+        h.name = r.histograms[i].name;
+        h.help = r.histograms[i].help;
+        h.count = h.sum = 0;
+        h.buckets.assign(kHistogramBuckets, 0);
+        for (MetricThreadBlock* b : r.blocks) {
+            const MetricHistogramCells& cells = b->histograms[i];
+            h.count += load(cells.count);
+            h.sum += load(cells.sum);
+            for (int k = 0; k < kHistogramBuckets; ++k) h.buckets[k] += load(cells.buckets[k]);
+        }
+        while (!h.buckets.empty() && h.buckets.back() == 0) h.buckets.pop_back();
+        snap.histograms.push_back(h);
+    }
+    return snap;
+}
+
+void Metrics::reset() {
+    Registry& r = registry();
+    std::lock_guard<std::mutex> guard(r.lock);
+    for (MetricThreadBlock* b : r.blocks) {
+        for (auto& c : b->counters) c.store(0, std::memory_order_relaxed);
+        for (auto& h : b->histograms) {
+            for (auto& k : h.buckets) k.store(0, std::memory_order_relaxed);
+            h.count.store(0, std::memory_order_relaxed);
+            h.sum.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+std::string MetricsSnapshot::toJson() const {
+    std::ostringstream ss;
+    ss << "{\"counters\":{";
+    for (size_t i = 0; i < counters.size(); ++i) {
+        ss << (i ? "," : "") << "\"" << jsonEscape(counters[i].name) << "\":" << counters[i].value;
+    }
+    ss << "},\"histograms\":{";
+    for (size_t i = 0; i < histograms.size(); ++i) {
+        const Histogram& h = histograms[i];
+        ss << (i ? "," : "") << "\"" << jsonEscape(h.name) << "\":{\"count\":" << h.count
+           << ",\"sum\":" << h.sum << ",\"log2_buckets\":[";
+        for (size_t k = 0; k < h.buckets.size(); ++k) ss << (k ? "," : "") << h.buckets[k];
+        ss << "]}";
+    }
+    ss << "}}";
+    return ss.str();
+}
+
+std::string MetricsSnapshot::toPrometheus() const {
+    std::ostringstream ss;
+    for (const Counter& c : counters) {
+        ss << "# HELP " << c.name << " " << c.help << "\n"
+           << "# TYPE " << c.name << " counter\n"
+           << c.name << " " << c.value << "\n";
+    }
+    for (const Histogram& h : histograms) {
+        ss << "# HELP " << h.name << " " << h.help << "\n"
+           << "# TYPE " << h.name << " histogram\n";
+        uint64_t cumulative = 0;
+        for (size_t k = 0; k < h.buckets.size(); ++k) {
+            cumulative += h.buckets[k];
+            uint64_t upper = k == 0 ? 0 : (k >= 64 ? ~0ULL : (1ULL << k) - 1);
+            ss << h.name << "_bucket{le=\"" << upper << "\"} " << cumulative << "\n";
+        }
+        ss << h.name << "_bucket{le=\"+Inf\"} " << h.count << "\n"
+           << h.name << "_sum " << h.sum << "\n"
+           << h.name << "_count " << h.count << "\n";
+    }
+    return ss.str();
+}
@@ -0,0 +1,149 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// ------------------------------
+// Instrumentation layer
+// ------------------------------
+// Counters and log2 histograms that the ADTs bump from their hot paths.
+// Every thread writes only to its own block of cells (no locks, no shared
+// cache lines); a snapshot sums the blocks of all threads, past and present.
+//
+// The hooks are the METRIC_* macros at the bottom. Unless the build defines
+// ENABLE_METRICS they expand to nothing, so the instrumented code compiles
+// to exactly what it was and metrics.cpp need not be linked. Snapshots of
+// an uninstrumented build are simply empty.
+
+const int kMaxCounters = 64;
+const int kMaxHistograms = 32;
+const int kHistogramBuckets = 65;   // bucket i holds values of bit width i: 0, 1, 2-3, 4-7, ...
+
+struct MetricHistogramCells {
+    std::atomic<uint64_t> buckets[kHistogramBuckets];
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum;
+};
+
+// One thread's cells; the extra last slot of each array absorbs metrics
+// registered past the limits
+struct MetricThreadBlock {
+    std::atomic<uint64_t> counters[kMaxCounters + 1];
+    MetricHistogramCells histograms[kMaxHistograms + 1];
+};
+
+// Registers the calling thread's block (metrics.cpp)
+MetricThreadBlock* attachMetricThread();
+
+inline MetricThreadBlock& localMetricBlock() {
+    static thread_local MetricThreadBlock* block = nullptr;
+    if (!block) block = attachMetricThread();
+    return *block;
+}
+
+// Only the owning thread writes a cell, so a relaxed load + store is enough
+// and compiles to a plain add; readers on other threads still see whole values
+inline void bumpCell(std::atomic<uint64_t>& cell, uint64_t n) {
+    cell.store(cell.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+// ------------------------------
+// Metric handles
+// ------------------------------
+// Declared as statics next to the code they measure (METRIC_COUNTER /
+// METRIC_HISTOGRAM); the name is used as is in both export formats
+class MetricCounter {
+public:
+    MetricCounter(const char* name, const char* help);
+
+    void add(uint64_t n = 1) { bumpCell(localMetricBlock().counters[id], n); }
+
+private:
+    int id;
+};
+
+class MetricHistogram {
+public:
+    MetricHistogram(const char* name, const char* help);
+
+    void record(uint64_t value) {
+        MetricHistogramCells& h = localMetricBlock().histograms[id];
+        int bucket = value ? 64 - __builtin_clzll(value) : 0;
+        bumpCell(h.buckets[bucket], 1);
+        bumpCell(h.count, 1);
+        bumpCell(h.sum, value);
+    }
+
+private:
+    int id;
+};
+
+// Records the lifetime of the enclosing scope, in nanoseconds
+class MetricTimer {
+public:
+    explicit MetricTimer(MetricHistogram& h) : hist(h), start(std::chrono::steady_clock::now()) {}
+    ~MetricTimer() {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        hist.record(static_cast<uint64_t>(ns));
+    }
+
+private:
+    MetricHistogram& hist;
+    std::chrono::steady_clock::time_point start;
+};
+
+// ------------------------------
+// Snapshots and export
+// ------------------------------
+struct MetricsSnapshot {
+    struct Counter {
+        std::string name, help;
+        uint64_t value;
+    };
+    struct Histogram {
+        std::string name, help;
+        uint64_t count, sum;
+        std::vector<uint64_t> buckets;   // trailing empty buckets trimmed
+
+        double mean() const { return count ? static_cast<double>(sum) / count : 0.0; }
+    };
+
+    std::vector<Counter> counters;
+    std::vector<Histogram> histograms;
+
+    std::string toJson() const;
+    std::string toPrometheus() const;   // text exposition format, bucket bounds 2^i - 1
+};
+
+class Metrics {
+public:
+    // Sum of every thread's cells at this moment
+    static MetricsSnapshot snapshot();
+
+    // Zero every cell; counts recorded by other threads meanwhile may be lost
+    static void reset();
+};
+
+// ------------------------------
+// Hooks
+// ------------------------------
+#ifdef ENABLE_METRICS
+#define METRIC_COUNTER(var, name, help) static MetricCounter var(name, help)
+#define METRIC_HISTOGRAM(var, name, help) static MetricHistogram var(name, help)
+#define METRIC_ADD(var, n) (var).add(n)
+#define METRIC_RECORD(var, value) (var).record(value)
+#define METRIC_TIME(var) MetricTimer var##Timer(var)
+#else
+#define METRIC_COUNTER(var, name, help)
+#define METRIC_HISTOGRAM(var, name, help)
+#define METRIC_ADD(var, n) ((void)sizeof(n))
+#define METRIC_RECORD(var, value) ((void)sizeof(value))
+#define METRIC_TIME(var) ((void)0)
+#endif
+
+#endif // METRICS_H
@@ -0,0 +1,49 @@
+#include "metrics.h"
+#include "polynomial.h"
+#include "texteditor.h"
+#include "uno.h"
+#include <iostream>
+#include <chrono>
+
+using namespace std;
+
+int main() {
+    auto start = chrono::steady_clock::now();
+
+    // Polynomial: build two dense polynomials and combine them
+    auto p = Polynomial::create();
+    auto q = Polynomial::create();
+    for (int e = 0; e < 300; ++e) {
+        p->insertTerm(e % 7 + 1, e);
+        q->insertTerm(e % 5 - 2, 2 * e);
+    }
+    auto prod = p->multiply(*q);
+    auto sum = prod->add(*p);
+
+    // Text editor: type, move around and read the text back
+    auto ed = TextEditor::create();
+    for (int i = 0; i < 2000; ++i) {
+        ed->insertChar(static_cast<char>('a' + i % 26));
+        if (i % 10 == 0) ed->moveLeft();
+        if (i % 50 == 0) ed->getTextWithCursor();
+    }
+
+    // UNO: a batch of full games
+    for (int g = 0; g < 20000; ++g) {
+        auto game = UNOGame::create(4, 99, g);
+        game->initialize();
+        while (!game->isGameOver() && game->getStats().turns < 5000) game->playTurn();
+    }
+
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Workload: " << seconds << " s" << endl << endl;
+
+    MetricsSnapshot snap = Metrics::snapshot();
+    if (snap.counters.empty() && snap.histograms.empty()) {
+        cout << "No metrics: build with -DENABLE_METRICS" << endl;
+        return 0;
+    }
+    cout << snap.toJson() << endl << endl;
+    cout << snap.toPrometheus();
+    return 0;
+}
@@ -1,76 +1,235 @@
 #include "polynomial.h"
+#include "metrics.h"
 #include <memory>
 #include <sstream>
 #include <iostream>
+#include <vector>
+#include <algorithm>
 
 using namespace std;
 
-// Term node for linked list
+METRIC_COUNTER(termAllocations, "polynomial_term_allocations_total", "Term nodes allocated");
+METRIC_COUNTER(nodesCopied, "polynomial_cow_copies_total", "Shared term nodes copied before a write");
+METRIC_HISTOGRAM(insertWalk, "polynomial_insert_walk_length", "Nodes walked per sorted insert");
+METRIC_HISTOGRAM(addLatency, "polynomial_add_latency_ns", "Wall time of add()");
+METRIC_HISTOGRAM(multiplyLatency, "polynomial_multiply_latency_ns", "Wall time of multiply()");
+METRIC_HISTOGRAM(powLatency, "polynomial_pow_latency_ns", "Wall time of pow()");
+METRIC_HISTOGRAM(composeLatency, "polynomial_compose_latency_ns", "Wall time of compose()");
+
+// Term node for linked list. Nodes are reference counted and shared
+// between polynomials: a node reachable from more than one polynomial is
+// never modified, it is copied first (see insertSorted).
 struct TermNode {
     int coefficient;
     int exponent;
-    unique_ptr<TermNode> next;
+    shared_ptr<TermNode> next;
     
-    TermNode(int coeff, int exp) : coefficient(coeff), exponent(exp), next(nullptr) {}
+    TermNode(int coeff, int exp, shared_ptr<TermNode> rest = nullptr)
+        : coefficient(coeff), exponent(exp), next(move(rest)) {}
+};
+
+// ------------------------------
+// Flat-buffer arithmetic
+// ------------------------------
+// multiply, pow and compose work on flat term arrays (highest exponent
+// first) and only build a linked list for the final result. The arrays
+// live in a per-thread workspace and are reused from call to call, so a
+// long chain of squarings allocates nothing once the buffers have grown.
+namespace {
+
+struct Term {
+    int coefficient;
+    int exponent;
+};
+typedef vector<Term> TermBuffer;
+
+const int kNoCap = -1;
+
+struct Workspace {
+    vector<long long> dense;     // multiplyInto accumulator
+    TermBuffer products;         // multiplyInto sparse path
+    TermBuffer powBase, powTmp;  // powInto
+    TermBuffer lhs, rhs, acc, tmp;
+    vector<TermBuffer> powers;   // compose: q^gap for each distinct gap
+    vector<int> gaps;
 };
 
+Workspace& workspace() {
+    static thread_local Workspace ws;
+    return ws;
+}
+
+// out = a * b, dropping terms above maxDegree (kNoCap: keep all).
+// out must not be a or b.
+void multiplyInto(const TermBuffer& a, const TermBuffer& b, int maxDegree, TermBuffer& out) {
+    out.clear();
+    if (a.empty() || b.empty()) return;
+    Workspace& ws = workspace();
+
+    long long low = static_cast<long long>(a.back().exponent) + b.back().exponent;
+    long long high = static_cast<long long>(a.front().exponent) + b.front().exponent;
+    if (maxDegree != kNoCap) high = min<long long>(high, maxDegree);
+    if (high < low) return;
+    long long range = high - low + 1;
+    long long pairs = static_cast<long long>(a.size()) * b.size();
+
+    if (range <= 2 * pairs + 64) {
+        // Exponents are dense enough: accumulate by exponent, then read out
+        ws.dense.assign(static_cast<size_t>(range), 0);
+        for (const Term& x : a) {
+            for (const Term& y : b) {
+                long long e = static_cast<long long>(x.exponent) + y.exponent;
+                if (e > high) continue;
+                ws.dense[e - low] += static_cast<long long>(x.coefficient) * y.coefficient;
+            }
+        }
+        for (long long i = range - 1; i >= 0; --i) {
+            int c = static_cast<int>(ws.dense[i]);
+            if (c != 0) out.push_back(Term{ c, static_cast<int>(i + low) });
+        }
+        return;
+    }
+
+    // Sparse: every product, sorted by exponent, like terms combined
+    ws.products.clear();
+    for (const Term& x : a) {
+        for (const Term& y : b) {
+            long long e = static_cast<long long>(x.exponent) + y.exponent;
+            if (e > high) continue;
+            ws.products.push_back(Term{ x.coefficient * y.coefficient, static_cast<int>(e) });
+        }
+    }
+    sort(ws.products.begin(), ws.products.end(),
+         [](const Term& x, const Term& y) { return x.exponent > y.exponent; });
+    for (size_t i = 0; i < ws.products.size();) {
+        int e = ws.products[i].exponent;
+        int c = 0;
+        for (; i < ws.products.size() && ws.products[i].exponent == e; ++i) c += ws.products[i].coefficient;
+        if (c != 0) out.push_back(Term{ c, e });
+    }
+}
+
+// Drop terms above maxDegree
+void truncate(TermBuffer& buf, int maxDegree) {
+    if (maxDegree == kNoCap) return;
+    size_t skip = 0;
+    while (skip < buf.size() && buf[skip].exponent > maxDegree) ++skip;
+    buf.erase(buf.begin(), buf.begin() + skip);
+}
+
+// out = base^k by repeated squaring (k >= 0). out must not be base.
+void powInto(const TermBuffer& base, int k, int maxDegree, TermBuffer& out) {
+    Workspace& ws = workspace();
+    out.assign(1, Term{ 1, 0 });
+    truncate(out, maxDegree);
+    ws.powBase = base;
+    truncate(ws.powBase, maxDegree);
+    while (k > 0) {
+        if (k & 1) {
+            multiplyInto(out, ws.powBase, maxDegree, ws.powTmp);
+            out.swap(ws.powTmp);
+        }
+        k >>= 1;
+        if (k > 0) {
+            multiplyInto(ws.powBase, ws.powBase, maxDegree, ws.powTmp);
+            ws.powBase.swap(ws.powTmp);
+        }
+    }
+}
+
+// buf += c (constant term)
+void addConstant(TermBuffer& buf, int c) {
+    if (c == 0) return;
+    size_t i = buf.size();
+    while (i > 0 && buf[i - 1].exponent < 0) --i;
+    if (i > 0 && buf[i - 1].exponent == 0) {
+        buf[i - 1].coefficient += c;
+        if (buf[i - 1].coefficient == 0) buf.erase(buf.begin() + (i - 1));
+    } else {
+        buf.insert(buf.begin() + i, Term{ c, 0 });
+    }
+}
+
+} // namespace
+
 class ConcretePolynomial : public Polynomial {
 private:
-    unique_ptr<TermNode> head;
+    shared_ptr<TermNode> head;
     
-    // Helper to insert term maintaining sorted order (highest exponent first)
+    static shared_ptr<TermNode> newNode(int coefficient, int exponent, shared_ptr<TermNode> rest = nullptr) {
+        METRIC_ADD(termAllocations, 1);
+        return make_shared<TermNode>(coefficient, exponent, move(rest));
+    }
+    
+    void toBuffer(TermBuffer& out) const {
+        out.clear();
+        for (TermNode* current = head.get(); current; current = current->next.get()) {
+            out.push_back(Term{ current->coefficient, current->exponent });
+        }
+    }
+    
+    static unique_ptr<ConcretePolynomial> fromBuffer(const TermBuffer& buf) {
+        auto result = make_unique<ConcretePolynomial>();
+        shared_ptr<TermNode>* tail = &result->head;
+        for (const Term& t : buf) {
+            *tail = newNode(t.coefficient, t.exponent);
+            tail = &(*tail)->next;
+        }
+        return result;
+    }
+    
+    // Helper to insert term maintaining sorted order (highest exponent first).
+    // Copy-on-write: nodes before the insertion point are copied only if
+    // they are shared; the rest of the list is never touched.
     void insertSorted(int coefficient, int exponent) {
         if (coefficient == 0) return;
         
-        // Create new node
-        auto newNode = make_unique<TermNode>(coefficient, exponent);
-        
-        // If list is empty or new node has higher exponent than head
-        if (!head || exponent > head->exponent) {
-            newNode->next = move(head);
-            head = move(newNode);
-            return;
-        }
-        
-        // Find insertion point
-        TermNode* current = head.get();
-        TermNode* prev = nullptr;
-        
-        while (current && current->exponent > exponent) {
-            prev = current;
-            current = current->next.get();
+        // Find insertion point, unsharing the path on the way
+        shared_ptr<TermNode>* link = &head;
+        uint64_t walked = 0;
+        while (*link && (*link)->exponent > exponent) {
+            if (link->use_count() > 1) {
+                *link = newNode((*link)->coefficient, (*link)->exponent, (*link)->next);
+                METRIC_ADD(nodesCopied, 1);
+            }
+            link = &(*link)->next;
+            ++walked;
         }
+        METRIC_RECORD(insertWalk, walked);
         
         // Combine like terms if found
-        if (current && current->exponent == exponent) {
-            current->coefficient += coefficient;
-            if (current->coefficient == 0) {
-                // Remove the term if coefficient becomes zero
-                if (prev) {
-                    prev->next = move(current->next);
-                } else {
-                    head = move(head->next);
-                }
+        if (*link && (*link)->exponent == exponent) {
+            int sum = (*link)->coefficient + coefficient;
+            if (sum == 0) {
+                // Remove the term if coefficient becomes zero (take the rest
+                // first: the assignment may free the node holding it)
+                shared_ptr<TermNode> rest = (*link)->next;
+                *link = move(rest);
+            } else if (link->use_count() > 1) {
+                *link = newNode(sum, exponent, (*link)->next);
+                METRIC_ADD(nodesCopied, 1);
+            } else {
+                (*link)->coefficient = sum;
             }
             return;
         }
         
         // Insert new term
-        if (prev) {
-            newNode->next = move(prev->next);
-            prev->next = move(newNode);
-        }
+        *link = newNode(coefficient, exponent, *link);
     }
     
 public:
     ConcretePolynomial() : head(nullptr) {}
     
-    // Copy constructor for operations
-    ConcretePolynomial(const ConcretePolynomial& other) : head(nullptr) {
-        TermNode* current = other.head.get();
-        while (current) {
-            insertTerm(current->coefficient, current->exponent);
-            current = current->next.get();
+    // Copies share all terms: O(1)
+    ConcretePolynomial(const ConcretePolynomial& other) : head(other.head) {}
+    
+    // Free the nodes only this polynomial holds iteratively rather than
+    // through a chain of recursive destructor calls
+    ~ConcretePolynomial() override {
+        while (head && head.use_count() == 1) {
+            shared_ptr<TermNode> rest = move(head->next);
+            head = move(rest);
         }
     }
     
@@ -127,70 +286,123 @@ public:
     }
     
     unique_ptr<Polynomial> add(const Polynomial& other) const override {
+        METRIC_TIME(addLatency);
         const ConcretePolynomial& otherPoly = dynamic_cast<const ConcretePolynomial&>(other);
         auto result = make_unique<ConcretePolynomial>();
         
-        // Merge two sorted linked lists
-        TermNode* current1 = head.get();
-        TermNode* current2 = otherPoly.head.get();
+        // Merge two sorted linked lists, appending at the tail. Once either
+        // list runs out the rest of the other one is shared, not copied, so
+        // adding zero or a polynomial of lower degree costs only the overlap.
+        const shared_ptr<TermNode>* current1 = &head;
+        const shared_ptr<TermNode>* current2 = &otherPoly.head;
+        shared_ptr<TermNode>* tail = &result->head;
         
-        while (current1 || current2) {
-            if (current1 && current2) {
-                if (current1->exponent > current2->exponent) {
-                    result->insertTerm(current1->coefficient, current1->exponent);
-                    current1 = current1->next.get();
-                } else if (current1->exponent < current2->exponent) {
-                    result->insertTerm(current2->coefficient, current2->exponent);
-                    current2 = current2->next.get();
-                } else {
-                    int sum = current1->coefficient + current2->coefficient;
-                    if (sum != 0) {
-                        result->insertTerm(sum, current1->exponent);
-                    }
-                    current1 = current1->next.get();
-                    current2 = current2->next.get();
-                }
-            } else if (current1) {
-                result->insertTerm(current1->coefficient, current1->exponent);
-                current1 = current1->next.get();
+        while (*current1 && *current2) {
+            const TermNode& term1 = **current1;
+            const TermNode& term2 = **current2;
+            if (term1.exponent > term2.exponent) {
+                *tail = newNode(term1.coefficient, term1.exponent);
+                current1 = &term1.next;
+            } else if (term1.exponent < term2.exponent) {
+                *tail = newNode(term2.coefficient, term2.exponent);
+                current2 = &term2.next;
             } else {
-                result->insertTerm(current2->coefficient, current2->exponent);
-                current2 = current2->next.get();
+                int sum = term1.coefficient + term2.coefficient;
+                if (sum != 0) {
+                    *tail = newNode(sum, term1.exponent);
+                }
+                current1 = &term1.next;
+                current2 = &term2.next;
             }
+            if (*tail) tail = &(*tail)->next;
         }
         
+        // Share whichever list is left
+        *tail = *current1 ? *current1 : *current2;
+        
         return result;
     }
     
     unique_ptr<Polynomial> multiply(const Polynomial& other) const override {
+        METRIC_TIME(multiplyLatency);
         const ConcretePolynomial& otherPoly = dynamic_cast<const ConcretePolynomial&>(other);
-        auto result = make_unique<ConcretePolynomial>();
+        Workspace& ws = workspace();
+        toBuffer(ws.lhs);
+        otherPoly.toBuffer(ws.rhs);
+        multiplyInto(ws.lhs, ws.rhs, kNoCap, ws.acc);
+        return fromBuffer(ws.acc);
+    }
+    
+    unique_ptr<Polynomial> pow(int k, int maxDegree) const override {
+        METRIC_TIME(powLatency);
+        if (k < 0) return nullptr;
+        Workspace& ws = workspace();
+        toBuffer(ws.lhs);
+        powInto(ws.lhs, k, maxDegree < 0 ? kNoCap : maxDegree, ws.acc);
+        return fromBuffer(ws.acc);
+    }
+    
+    unique_ptr<Polynomial> compose(const Polynomial& q, int maxDegree) const override {
+        METRIC_TIME(composeLatency);
+        const ConcretePolynomial& inner = dynamic_cast<const ConcretePolynomial&>(q);
+        Workspace& ws = workspace();
+        int cap = maxDegree < 0 ? kNoCap : maxDegree;
+        toBuffer(ws.lhs);
+        if (!ws.lhs.empty() && ws.lhs.back().exponent < 0) return nullptr;  // lowest term last
+        inner.toBuffer(ws.rhs);
         
-        // Multiply each term from this polynomial with each term from other polynomial
-        for (TermNode* term1 = head.get(); term1; term1 = term1->next.get()) {
-            for (TermNode* term2 = otherPoly.head.get(); term2; term2 = term2->next.get()) {
-                int newCoeff = term1->coefficient * term2->coefficient;
-                int newExp = term1->exponent + term2->exponent;
-                result->insertTerm(newCoeff, newExp);
+        // Horner over the sparse terms c_i x^e_i:
+        //   acc = c_0;  acc = acc * q^(e_(i-1) - e_i) + c_i;  acc *= q^e_last
+        // with each distinct gap's power of q computed once by repeated squaring
+        ws.gaps.clear();
+        auto power = [&ws, cap](int gap) -> const TermBuffer& {
+            for (size_t i = 0; i < ws.gaps.size(); ++i) {
+                if (ws.gaps[i] == gap) return ws.powers[i];
             }
-        }
+            if (ws.powers.size() <= ws.gaps.size()) ws.powers.emplace_back();
+            TermBuffer& slot = ws.powers[ws.gaps.size()];
+            ws.gaps.push_back(gap);
+            powInto(ws.rhs, gap, cap, slot);
+            return slot;
+        };
         
-        return result;
+        ws.acc.clear();
+        for (size_t i = 0; i < ws.lhs.size(); ++i) {
+            if (i > 0) {
+                multiplyInto(ws.acc, power(ws.lhs[i - 1].exponent - ws.lhs[i].exponent), cap, ws.tmp);
+                ws.acc.swap(ws.tmp);
+            }
+            addConstant(ws.acc, ws.lhs[i].coefficient);
+            truncate(ws.acc, cap);
+        }
+        if (!ws.lhs.empty() && ws.lhs.back().exponent > 0) {
+            multiplyInto(ws.acc, power(ws.lhs.back().exponent), cap, ws.tmp);
+            ws.acc.swap(ws.tmp);
+        }
+        return fromBuffer(ws.acc);
     }
     
     unique_ptr<Polynomial> derivative() const override {
         auto result = make_unique<ConcretePolynomial>();
+        shared_ptr<TermNode>* tail = &result->head;
         
+        // Exponents stay in descending order, so append at the tail
         for (TermNode* current = head.get(); current; current = current->next.get()) {
             if (current->exponent > 0) {
                 int newCoeff = current->coefficient * current->exponent;
                 int newExp = current->exponent - 1;
-                result->insertTerm(newCoeff, newExp);
+                if (newCoeff == 0) continue;
+                *tail = newNode(newCoeff, newExp);
+                tail = &(*tail)->next;
             }
         }
         
         return result;
     }
+    
+    unique_ptr<Polynomial> clone() const override {
+        return make_unique<ConcretePolynomial>(*this);
+    }
 };
 
 // Factory function
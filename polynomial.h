@@ -20,9 +20,24 @@ public:
     // Return a new polynomial that is the product of this and other
     virtual std::unique_ptr<Polynomial> multiply(const Polynomial& other) const = 0;
 
+    // Return this polynomial raised to the power k by repeated squaring, or
+    // nullptr when k < 0 (there is no polynomial inverse). With maxDegree >= 0,
+    // terms above that degree are dropped as the computation goes (exact when
+    // no exponent is negative).
+    virtual std::unique_ptr<Polynomial> pow(int k, int maxDegree = -1) const = 0;
+
+    // Return this polynomial evaluated at q, i.e. p(q(x)), by Horner's
+    // scheme, or nullptr when this polynomial has a term with a negative
+    // exponent (q would need an inverse). maxDegree as for pow.
+    virtual std::unique_ptr<Polynomial> compose(const Polynomial& q, int maxDegree = -1) const = 0;
+
     // Return a new polynomial that is the derivative of this polynomial
     virtual std::unique_ptr<Polynomial> derivative() const = 0;
 
+    // Return a copy. Terms are shared copy-on-write, so this is O(1) and
+    // inserting into either copy never changes the other.
+    virtual std::unique_ptr<Polynomial> clone() const = 0;
+
     // Create a concrete instance
     static std::unique_ptr<Polynomial> create();
 };
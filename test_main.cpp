@@ -1,8 +1,31 @@
 #include "polynomial.h"
 #include <iostream>
+#include <string>
 
 using namespace std;
 
+static int failures = 0;
+
+// Print one result next to what it should be
+static void check(const string& label, const Polynomial& p, const string& expected) {
+    string got = p.toString();
+    bool ok = got == expected;
+    if (!ok) ++failures;
+    cout << label << ": " << got << (ok ? "" : "   <-- expected " + expected) << endl;
+}
+
+// Operations with no polynomial result must say so with nullptr
+static void checkRejected(const string& label, const unique_ptr<Polynomial>& p) {
+    if (p) ++failures;
+    cout << label << ": " << (p ? p->toString() + "   <-- expected nullptr" : "rejected") << endl;
+}
+
+static unique_ptr<Polynomial> poly(initializer_list<pair<int, int>> terms) {
+    auto p = Polynomial::create();
+    for (const auto& t : terms) p->insertTerm(t.first, t.second);
+    return p;
+}
+
 int main() {
     // Create p1: 3x^4 + 2x^2 - x + 5
     auto p1 = Polynomial::create();
@@ -35,5 +58,61 @@ int main() {
     cout << "prod.toString(): " << prod->toString() << endl;
     cout << "deriv.toString(): " << deriv->toString() << endl;
     
-    return 0;
+    // Copy-on-write: clones and add() results share nodes, and changing one
+    // side must never show through on the other
+    cout << endl;
+    auto base = poly({ { 3, 4 }, { 2, 2 }, { -1, 1 }, { 5, 0 } });
+    auto copy = base->clone();
+    copy->insertTerm(7, 3);
+    check("clone changed", *copy, "3x^4 + 7x^3 + 2x^2 - x + 5");
+    check("original after clone changed", *base, "3x^4 + 2x^2 - x + 5");
+    base->insertTerm(1, 0);
+    check("original changed", *base, "3x^4 + 2x^2 - x + 6");
+    check("clone after original changed", *copy, "3x^4 + 7x^3 + 2x^2 - x + 5");
+    
+    auto low = poly({ { 2, 2 }, { -1, 1 }, { 5, 0 } });
+    auto high = poly({ { 1, 10 }, { 4, 6 } });
+    auto shared = high->add(*low);          // ends in low's own nodes
+    low->insertTerm(-5, 0);
+    check("add result after operand changed", *shared, "x^10 + 4x^6 + 2x^2 - x + 5");
+    shared->insertTerm(3, 1);
+    check("add result changed", *shared, "x^10 + 4x^6 + 2x^2 + 2x + 5");
+    check("operand after add result changed", *low, "2x^2 - x");
+    
+    auto cancel = base->clone();
+    cancel->insertTerm(-2, 2);              // middle of the shared list
+    cancel->insertTerm(-3, 4);              // its head
+    check("cancelled terms on shared list", *cancel, "-x + 6");
+    cancel->insertTerm(1, 1);
+    cancel->insertTerm(-6, 0);
+    check("cancelled to zero", *cancel, "0");
+    check("original after clone cancelled", *base, "3x^4 + 2x^2 - x + 6");
+    
+    // Powers and composition
+    cout << endl;
+    auto xPlus1 = poly({ { 1, 1 }, { 1, 0 } });
+    check("(x + 1)^5", *xPlus1->pow(5), "x^5 + 5x^4 + 10x^3 + 10x^2 + 5x + 1");
+    check("(x + 1)^5 up to x^2", *xPlus1->pow(5, 2), "10x^2 + 5x + 1");
+    check("(x + 1)^0", *xPlus1->pow(0), "1");
+    check("0^0", *Polynomial::create()->pow(0), "1");
+    check("0^3", *Polynomial::create()->pow(3), "0");
+    check("(x + x^-1)^2", *poly({ { 1, 1 }, { 1, -1 } })->pow(2), "x^2 + 2 + x^-2");
+    check("(x^1000 - 1)^2", *poly({ { 1, 1000 }, { -1, 0 } })->pow(2), "x^2000 - 2x^1000 + 1");
+    checkRejected("(x + 1)^-3", xPlus1->pow(-3));
+    check("sparse product", *poly({ { 1, 500 }, { 1, 1 } })->multiply(*poly({ { 1, 300 }, { -1, 0 } })),
+          "x^800 - x^500 + x^301 - x");
+    check("dense product", *poly({ { 1, 2 }, { 1, 1 }, { 1, 0 } })->multiply(*poly({ { 1, 1 }, { -1, 0 } })),
+          "x^3 - 1");
+    
+    auto xMinus1 = poly({ { 1, 1 }, { -1, 0 } });
+    check("(x^2 + 1) o (x - 1)", *poly({ { 1, 2 }, { 1, 0 } })->compose(*xMinus1), "x^2 - 2x + 2");
+    check("(x^4 + 3) o (x + 1)", *poly({ { 1, 4 }, { 3, 0 } })->compose(*xPlus1), "x^4 + 4x^3 + 6x^2 + 4x + 4");
+    check("(x^4 + 3) o (x + 1) up to x^2", *poly({ { 1, 4 }, { 3, 0 } })->compose(*xPlus1, 2), "6x^2 + 4x + 4");
+    check("(2x^3 + x) o x^2", *poly({ { 2, 3 }, { 1, 1 } })->compose(*poly({ { 1, 2 } })), "2x^6 + x^2");
+    check("5 o (x - 1)", *poly({ { 5, 0 } })->compose(*xMinus1), "5");
+    check("p1(3)", *p1->compose(*poly({ { 3, 0 } })), "263");
+    checkRejected("(x^2 + x^-1) o (x + 1)", poly({ { 1, 2 }, { 1, -1 } })->compose(*xPlus1));
+    check("x^2 o (x + x^-1)", *poly({ { 1, 2 } })->compose(*poly({ { 1, 1 }, { 1, -1 } })), "x^2 + 2 + x^-2");
+    
+    return failures == 0 ? 0 : 1;
 }
\ No newline at end of file
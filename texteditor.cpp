@@ -1,10 +1,14 @@
 #include "texteditor.h"
+#include "metrics.h"
 #include <stack>
 #include <string>
 #include <sstream>
 #include <memory>
 using namespace std;
 
+METRIC_HISTOGRAM(getTextLatency, "texteditor_get_text_latency_ns", "Wall time of getTextWithCursor()");
+METRIC_HISTOGRAM(getTextLength, "texteditor_get_text_chars", "Characters copied out per getTextWithCursor()");
+
 class ConcreteTextEditor : public TextEditor {
 private:
     stack<char> left;   // characters before the cursor
@@ -43,6 +47,8 @@ public:
     }
 
     string getTextWithCursor() const override {
+        METRIC_TIME(getTextLatency);
+        METRIC_RECORD(getTextLength, left.size() + right.size());
         string leftStr, rightStr;
         stack<char> tempLeft = left, tempRight = right;
 
@@ -1,458 +1,433 @@
 // uno.cpp
 #include "uno.h"
+#include "uno_strategy.h"
+#include "metrics.h"
 #include <iostream>
 #include <sstream>
-#include <random>
 #include <algorithm>
 #include <memory>
 #include <vector>
+#include <cstdint>
+#include <cstring>
 
 // ------------------------
-// Linked list node & list
+// Game engine on UNOState
 // ------------------------
-struct Node {
-    Card card;
-    Node* next;
-    Node(const Card& c) : card(c), next(nullptr) {}
-};
-
-class CardLinkedList {
-private:
-    Node* head;
-    Node* tail;
-    int sz;
-public:
-    CardLinkedList() : head(nullptr), tail(nullptr), sz(0) {}
-    ~CardLinkedList() { clear(); }
-
-    void clear() {
-        Node* p = head;
-        while (p) {
-            Node* t = p;
-            p = p->next;
-            delete t;
-        }
-        head = tail = nullptr;
-        sz = 0;
-    }
-
-    bool isEmpty() const { return head == nullptr; }
-    int getSize() const { return sz; }
-
-    void pushBack(const Card& c) {
-        Node* n = new Node(c);
-        if (!head) head = tail = n;
-        else {
-            tail->next = n;
-            tail = n;
-        }
-        ++sz;
-    }
-
-    void pushFront(const Card& c) {
-        Node* n = new Node(c);
-        n->next = head;
-        head = n;
-        if (!tail) tail = n;
-        ++sz;
-    }
-
-    Card popFront() {
-        if (!head) return Card();
-        Node* n = head;
-        Card c = n->card;
-        head = head->next;
-        if (!head) tail = nullptr;
-        delete n;
-        --sz;
-        return c;
-    }
-
-    Card getFront() const {
-        if (!head) return Card();
-        return head->card;
-    }
-
-    Card getBack() const {
-        if (!tail) return Card();
-        return tail->card;
+namespace {
+
+METRIC_COUNTER(gamesDealt, "uno_games_dealt_total", "Games dealt");
+METRIC_COUNTER(reshuffles, "uno_reshuffles_total", "Discard pile recycled into the deck");
+METRIC_HISTOGRAM(reshuffleSize, "uno_reshuffle_cards", "Cards in the deck after a reshuffle");
+
+// compute next index from idx by steps according to direction dir
+int nextIndexFrom(const UNOState& s, int idx, int steps, bool dir) {
+    int n = s.numPlayers;
+    if (n == 0) return 0;
+    int st = ((steps % n) + n) % n;
+    if (dir) { // clockwise
+        return (idx + st) % n;
+    } else {
+        int val = (idx - st) % n;
+        if (val < 0) val += n;
+        return val;
     }
+}
 
-    // remove first card matching the supplied card (color,type,number)
-    bool removeCard(const Card& cardToRemove) {
-    if (!head) return false;
-
-    Node* current = head;
-    Node* previous = nullptr;
-
-    while (current != nullptr) {
-        if (current->card == cardToRemove) {
-            // Found the card to remove
-            if (previous == nullptr) {
-                // Removing the head node
-                head = current->next;
-            } else {
-                previous->next = current->next;
-            }
-
-            // Update tail if necessary
-            if (current == tail) {
-                tail = previous;
-            }
-
-            delete current;
-            sz--;
-            return true;
-        }
-
-        previous = current;
-        current = current->next;
-    }
+void advance(UNOState& s, int steps) {
+    s.currentPlayer = static_cast<uint8_t>(nextIndexFrom(s, s.currentPlayer, steps, s.clockwise));
+}
 
-    return false;
+void countPlayed(UNOGameStats* stats, CardCode c) {
+    if (!stats) return;
+    int kind = codeKind(c);
+    stats->cardsPlayed[kind <= 9 ? Card::NUMBER : kind - 9]++;
 }
 
-    // find playable card according to rules:
-    // 1) color match (first encountered)
-    // 2) value match (number) (first encountered)
-    // 3) action cards in order Skip -> Reverse -> Draw Two (first encountered)
-   bool findPlayable(const Card& topCard, Card& chosen) const {
-    
-    // First pass: find all playable cards
-    std::vector<Card> playableCards;
-    Node* cur = head;
-    while (cur) {
-        if (cur->card.matches(topCard)) {
-            playableCards.push_back(cur->card);
-        }
-        cur = cur->next;
-    }
-    
-    if (playableCards.empty()) {
-        return false;
-    }
-    
-    // Apply priority: color match > value match > action cards (Skip > Reverse > Draw Two)
-    
-    // 1. Look for color matches first
-    for (const Card& card : playableCards) {
-        if (card.color == topCard.color) {
-            chosen = card;
-            return true;
+// Draw a card (handles reshuffle from discard if deck empty)
+CardCode drawCard(UNOState& s, UNOUndo& undo, UNOGameStats* stats) {
+    CardPile& pile = s.pile;
+    if (pile.deckCount == 0 && pile.discardCount > 1) {
+        if (!undo.reshuffled) {
+            std::memcpy(undo.pileCards, pile.cards, sizeof(pile.cards));
+            undo.reshuffled = true;
         }
+        pile.recycleDiscard(s.rng);
+        if (stats) stats->reshuffles++;
+        METRIC_ADD(reshuffles, 1);
+        METRIC_RECORD(reshuffleSize, pile.deckCount);
     }
-    
-    // 2. Look for number matches
-    for (const Card& card : playableCards) {
-        if (card.type == Card::NUMBER && topCard.type == Card::NUMBER && card.number == topCard.number) {
-            chosen = card;
-            return true;
-        }
-    }
-    
-    // 3. Look for action cards in priority order
-    const Card::Type actionOrder[] = {Card::SKIP, Card::REVERSE, Card::DRAW_TWO};
-    for (Card::Type actionType : actionOrder) {
-        for (const Card& card : playableCards) {
-            if (card.type == actionType) {
-                chosen = card;
-                return true;
-            }
-        }
-    }
-    
-    // Fallback: just return the first playable card
-    chosen = playableCards[0];
-    return true;
+    return pile.drawFront(); // kNoCard when both piles are exhausted
 }
-    // Convert to vector (useful for reshuffle)
-    std::vector<Card> toVector() const {
-        std::vector<Card> out;
-        Node* cur = head;
-        while (cur) {
-            out.push_back(cur->card);
-            cur = cur->next;
-        }
-        return out;
-    }
-};
-
-// -------------------------------
-// Concrete UNOGame implementation
-// -------------------------------
-class ConcreteUNOGame : public UNOGame {
-private:
-    int numPlayers;
-    int currentPlayer;
-    bool clockwise;
-    std::vector<CardLinkedList> hands; // linked list per player
-    CardLinkedList deck;               // deck: popFront draws next card
-    CardLinkedList discard;            // discard: getBack() is top
-    bool gameOverFlag;
-    int winnerIdx;
-
-    std::mt19937 rng; // seeded in constructor
 
-public:
-    ConcreteUNOGame(int n)
-        : UNOGame(n),
-          numPlayers(n),
-          currentPlayer(0),
-          clockwise(true),
-          hands(n),
-          deck(),
-          discard(),
-          gameOverFlag(false),
-          winnerIdx(-1),
-          rng(std::mt19937(1234)) // seed deterministically once
-    {}
-
-    ~ConcreteUNOGame() override {
-        // destructor: CardLinkedList destructors clear nodes
+void giveCard(UNOState& s, int player, CardCode c, UNOUndo& undo) {
+    CardHand& hand = s.hands[player];
+    if (hand.nextOrder == CardHand::kEmpty && undo.renumberedAt < 0) {
+        undo.renumberedHand = hand;
+        undo.renumberedAt = static_cast<int8_t>(undo.numPushed);
     }
+    hand.pushBack(c);
+    undo.pushedTo[undo.numPushed] = static_cast<uint8_t>(player);
+    undo.pushedCard[undo.numPushed] = c;
+    undo.numPushed++;
+}
 
-    // Helper to draw a card (handles reshuffle from discard if deck empty)
-    Card drawCard() {
-        if (deck.isEmpty()) {
-            // Reshuffle discard except top into deck
-            if (discard.getSize() > 1) {
-                // collect all except last (top)
-                std::vector<Card> pool;
-                // get discard as vector
-                std::vector<Card> dvec = discard.toVector();
-                Card top = dvec.back();
-                // pool <- first n-1
-                for (size_t i = 0; i + 1 < dvec.size(); ++i) pool.push_back(dvec[i]);
-                // clear discard and push back top only
-                discard.clear();
-                discard.pushBack(top);
-                // shuffle pool and populate deck
-                std::shuffle(pool.begin(), pool.end(), rng);
-                for (auto &c : pool) deck.pushBack(c);
-            }
+// apply effect of a card just played & set next currentPlayer
+void applyEffect(UNOState& s, CardCode played, UNOUndo& undo, UNOGameStats* stats) {
+    int kind = codeKind(played);
+    if (kind <= 9) {
+        advance(s, 1);
+    } else if (kind == kKindSkip) {
+        // Skip means next player misses turn
+        advance(s, 2);
+    } else if (kind == kKindReverse) {
+        if (s.numPlayers == 2) {
+            // In 2-player, Reverse acts like Skip
+            advance(s, 2);
+        } else {
+            s.clockwise = !s.clockwise;
+            advance(s, 1);
         }
-        if (!deck.isEmpty()) {
-            return deck.popFront();
+    } else {
+        int victim = nextIndexFrom(s, s.currentPlayer, 1, s.clockwise);
+        // victim draws two
+        for (int d = 0; d < 2; ++d) {
+            CardCode dc = drawCard(s, undo, stats);
+            if (dc == kNoCard) break;
+            giveCard(s, victim, dc, undo);
         }
-        return Card(); // fallback: invalid card
+        // skip victim
+        advance(s, 2);
     }
+}
 
-    void initialize() override {
-    // Reset lists and flags
-    for (auto &h : hands) h.clear();
-    deck.clear();
-    discard.clear();
-
-    currentPlayer = 0;
-    clockwise = true;
-    gameOverFlag = false;
-    winnerIdx = -1;
-
-    // Build canonical deck vector
-    std::vector<Card> deckVec;
-    const Card::Color colors[] = { Card::RED, Card::GREEN, Card::BLUE, Card::YELLOW };
-    for (Card::Color c : colors) {
-        // One zero per color
-        deckVec.emplace_back(c, Card::NUMBER, 0);
-        // Two of each 1-9 per color
-        for (int v = 1; v <= 9; ++v) {
-            deckVec.emplace_back(c, Card::NUMBER, v);
-            deckVec.emplace_back(c, Card::NUMBER, v);
-        }
-        // action cards (two each)
-        deckVec.emplace_back(c, Card::SKIP, -1);
-        deckVec.emplace_back(c, Card::SKIP, -1);
-        deckVec.emplace_back(c, Card::REVERSE, -1);
-        deckVec.emplace_back(c, Card::REVERSE, -1);
-        deckVec.emplace_back(c, Card::DRAW_TWO, -1);
-        deckVec.emplace_back(c, Card::DRAW_TWO, -1);
-    }
+} // namespace
 
-    // Deterministic shuffle using seeded rng (member)
-    std::shuffle(deckVec.begin(), deckVec.end(), rng);
+void dealState(UNOState& s) {
+    METRIC_ADD(gamesDealt, 1);
+    // Reset hands, piles and flags
+    for (int p = 0; p < s.numPlayers; ++p) s.hands[p].clear();
+    s.pile.clear();
+    s.currentPlayer = 0;
+    s.clockwise = true;
+    s.gameOver = false;
+    s.winner = -1;
+
+    // Canonical deck is a compile-time table: copy it and shuffle
+    CardCode deckVec[kDeckSize];
+    const size_t deckSize = kDeckSize;
+    std::memcpy(deckVec, kCanonicalDeck.cards, sizeof(deckVec));
+    s.rng.shuffle(deckVec, kDeckSize);
 
     // Find first number card for initial discard
     size_t firstNumberCardIdx = 0;
-    while (firstNumberCardIdx < deckVec.size() && deckVec[firstNumberCardIdx].type != Card::NUMBER) {
+    while (firstNumberCardIdx < deckSize && codeKind(deckVec[firstNumberCardIdx]) > 9) {
         firstNumberCardIdx++;
     }
 
     // If no number card found, use first card (shouldn't happen with full deck)
-    if (firstNumberCardIdx >= deckVec.size()) {
+    if (firstNumberCardIdx >= deckSize) {
         firstNumberCardIdx = 0;
     }
 
-    // Set initial discard card
-    discard.pushBack(deckVec[firstNumberCardIdx]);
-
     // Deal 7 cards round-robin, skip the initial discard card
     size_t idx = 0;
     for (int r = 0; r < 7; ++r) {
-        for (int p = 0; p < numPlayers; ++p) {
+        for (int p = 0; p < s.numPlayers; ++p) {
             // Skip the card we used for initial discard
             if (idx == firstNumberCardIdx) {
                 idx++;
             }
-            if (idx >= deckVec.size()) break;
-            hands[p].pushBack(deckVec[idx++]);
+            if (idx >= deckSize) break;
+            s.hands[p].pushBack(deckVec[idx++]);
         }
     }
 
-    // Add remaining cards to deck, skip the initial discard card
-    for (size_t i = 0; i < deckVec.size(); ++i) {
-        if (i != firstNumberCardIdx) {
-            // Check if this card was already dealt to players
-            bool alreadyDealt = false;
-            for (const auto& hand : hands) {
-                // checks if we've passed the dealing index, this card wasn't dealt
-                if (i < idx && i != firstNumberCardIdx) {
-                    // add all cards except the initial discard
-                    // cards not refreshed at idx
-                }
-            }
-            if (i >= idx || i == firstNumberCardIdx) {
-                deck.pushBack(deckVec[i]);
-            }
-        }
+    // Everything not dealt (and not the initial discard) forms the deck, in
+    // shuffled order. The discard pile has to start after the deck in the ring.
+    for (size_t i = idx; i < deckSize; ++i) {
+        if (i != firstNumberCardIdx) s.pile.pushDeck(deckVec[i]);
     }
+    s.pile.pushDiscard(deckVec[firstNumberCardIdx]);
+}
 
-    // create a new vector without the initial discard card
-    std::vector<Card> remainingCards;
-    for (size_t i = 0; i < deckVec.size(); ++i) {
-        if (i != firstNumberCardIdx) {
-            remainingCards.push_back(deckVec[i]);
-        }
+int legalMoves(const UNOState& s, UNOMove out[kMaxMoves]) {
+    if (s.gameOver) return 0;
+    uint64_t p = s.hands[s.currentPlayer].playable(s.pile.top());
+    if (!p) {
+        out[0] = UNOMove::draw();
+        return 1;
     }
-    
-    // Shuffle the remaining cards and add to deck
-    std::shuffle(remainingCards.begin(), remainingCards.end(), rng);
-    for (const auto& card : remainingCards) {
-        deck.pushBack(card);
+    int n = 0;
+    while (p) {
+        out[n++] = UNOMove::play(static_cast<CardCode>(__builtin_ctzll(p)));
+        p &= p - 1;
     }
+    return n;
 }
 
-    void playTurn() override {
-    if (gameOverFlag) return;
+bool isLegalMove(const UNOState& s, const UNOMove& m) {
+    UNOMove legal[kMaxMoves];
+    int n = legalMoves(s, legal);
+    for (int i = 0; i < n; ++i) {
+        if (legal[i].kind == m.kind && (m.kind == UNOMove::DRAW || legal[i].card == m.card)) return true;
+    }
+    return false;
+}
+
+UNOMove greedyMove(const UNOState& s) {
+    CardCode chosen;
+    if (s.hands[s.currentPlayer].findPlayable(s.pile.top(), chosen)) return UNOMove::play(chosen);
+    return UNOMove::draw();
+}
 
-    if (discard.isEmpty()) {
-        currentPlayer = nextIndexFrom(currentPlayer, 1, clockwise);
+void makeMove(UNOState& s, const UNOMove& m, UNOUndo& undo, UNOGameStats* stats) {
+    undo.rng = s.rng;
+    undo.currentPlayer = s.currentPlayer;
+    undo.clockwise = s.clockwise;
+    undo.gameOver = s.gameOver;
+    undo.winner = s.winner;
+    undo.pileHead = s.pile.head;
+    undo.deckCount = s.pile.deckCount;
+    undo.discardCount = s.pile.discardCount;
+    undo.removed = kNoCard;
+    undo.mover = s.currentPlayer;
+    undo.drawn = kNoCard;
+    undo.drawnPlayed = false;
+    undo.numPushed = 0;
+    undo.reshuffled = false;
+    undo.renumberedAt = -1;
+
+    if (s.gameOver) return;
+    if (stats) stats->turns++;
+
+    CardCode top = s.pile.top();
+    if (top == kNoCard) {
+        advance(s, 1);
         return;
     }
 
-    Card top = discard.getBack();
-    Card chosen;
-    bool hasPlayable = hands[currentPlayer].findPlayable(top, chosen);
-
-    if (hasPlayable) {
+    if (m.kind == UNOMove::PLAY) {
         // play chosen
-        bool removed = hands[currentPlayer].removeCard(chosen);
-        discard.pushBack(chosen);
+        CardHand& hand = s.hands[s.currentPlayer];
+        undo.removed = m.card;
+        undo.removedStamp = hand.removeCard(m.card);
+        s.pile.pushDiscard(m.card);
+        countPlayed(stats, m.card);
 
         // check win immediately (player who played)
-        if (hands[currentPlayer].getSize() == 0) {
-            gameOverFlag = true;
-            winnerIdx = currentPlayer;
+        if (hand.isEmpty()) {
+            s.gameOver = true;
+            s.winner = static_cast<int8_t>(s.currentPlayer);
             return;
         }
 
-        // apply effect & set next currentPlayer
-        if (chosen.type == Card::NUMBER) {
-            currentPlayer = nextIndexFrom(currentPlayer, 1, clockwise);
-        } else if (chosen.type == Card::SKIP) {
-            // Skip means next player misses turn
-            currentPlayer = nextIndexFrom(currentPlayer, 2, clockwise);
-        } else if (chosen.type == Card::REVERSE) {
-            if (numPlayers == 2) {
-                // In 2-player, Reverse acts like Skip
-                currentPlayer = nextIndexFrom(currentPlayer, 2, clockwise);
-            } else {
-                clockwise = !clockwise;
-                currentPlayer = nextIndexFrom(currentPlayer, 1, clockwise);
-            }
-        } else if (chosen.type == Card::DRAW_TWO) {
-            int victim = nextIndexFrom(currentPlayer, 1, clockwise);
-            // victim draws two
-            for (int d = 0; d < 2; ++d) {
-                Card dc = drawCard();
-                if (dc.type == Card::NUMBER && dc.color == Card::NONE && dc.number == -1) {
-                    break;
-                }
-                hands[victim].pushBack(dc);
-            }
-            // skip victim
-            currentPlayer = nextIndexFrom(currentPlayer, 2, clockwise);
-        }
-
+        applyEffect(s, m.card, undo, stats);
     } else {
         // draw one card
-        Card drawn = drawCard();
-        if (drawn.type == Card::NUMBER && drawn.color == Card::NONE && drawn.number == -1) {
-            currentPlayer = nextIndexFrom(currentPlayer, 1, clockwise);
+        CardCode drawn = drawCard(s, undo, stats);
+        undo.drawn = drawn;
+        if (drawn == kNoCard) {
+            advance(s, 1);
             return;
         }
 
-        // Check if drawn card matches top card
-        bool canPlayDrawn = drawn.matches(top);
-
-        if (canPlayDrawn) {
+        if (codesMatch(top, drawn)) {
             // play drawn immediately
-            discard.pushBack(drawn);
-            // apply drawn card effect
-            if (drawn.type == Card::NUMBER) {
-                currentPlayer = nextIndexFrom(currentPlayer, 1, clockwise);
-            } else if (drawn.type == Card::SKIP) {
-                currentPlayer = nextIndexFrom(currentPlayer, 2, clockwise);
-            } else if (drawn.type == Card::REVERSE) {
-                if (numPlayers == 2) {
-                    currentPlayer = nextIndexFrom(currentPlayer, 2, clockwise);
-                } else {
-                    clockwise = !clockwise;
-                    currentPlayer = nextIndexFrom(currentPlayer, 1, clockwise);
-                }
-            } else if (drawn.type == Card::DRAW_TWO) {
-                int victim = nextIndexFrom(currentPlayer, 1, clockwise);
-                for (int d = 0; d < 2; ++d) {
-                    Card dc = drawCard();
-                    if (dc.type == Card::NUMBER && dc.color == Card::NONE && dc.number == -1) break;
-                    hands[victim].pushBack(dc);
-                }
-                currentPlayer = nextIndexFrom(currentPlayer, 2, clockwise);
-            }
+            undo.drawnPlayed = true;
+            s.pile.pushDiscard(drawn);
+            countPlayed(stats, drawn);
+            applyEffect(s, drawn, undo, stats);
         } else {
             // cannot play drawn - add to hand and turn passes
-            hands[currentPlayer].pushBack(drawn);
-            currentPlayer = nextIndexFrom(currentPlayer, 1, clockwise);
+            giveCard(s, s.currentPlayer, drawn, undo);
+            advance(s, 1);
         }
     }
 }
-    bool isGameOver() const override { return gameOverFlag; }
-    int getWinner() const override { return winnerIdx; }
-
-    std::string getState() const override {
-        std::ostringstream ss;
-        ss << "Player " << currentPlayer << "'s turn, Direction: "
-           << (clockwise ? "Clockwise" : "Counter-clockwise")
-           << ", Top: " << (discard.isEmpty() ? Card().toString() : discard.getBack().toString())
-           << ", Players cards: ";
-        for (int i = 0; i < numPlayers; ++i) {
-            ss << "P" << i << ":" << hands[i].getSize();
-            if (i < numPlayers - 1) ss << ", ";
+
+void unmakeMove(UNOState& s, const UNOUndo& undo) {
+    for (int i = undo.numPushed - 1; i >= 0; --i) {
+        if (i == undo.renumberedAt) s.hands[undo.pushedTo[i]] = undo.renumberedHand;
+        else s.hands[undo.pushedTo[i]].popNewest(undo.pushedCard[i]);
+    }
+    if (undo.removed != kNoCard) {
+        s.hands[undo.mover].restoreOldest(undo.removed, undo.removedStamp);
+    }
+    if (undo.reshuffled) {
+        std::memcpy(s.pile.cards, undo.pileCards, sizeof(s.pile.cards));
+    }
+    s.rng = undo.rng;
+    s.currentPlayer = undo.currentPlayer;
+    s.clockwise = undo.clockwise;
+    s.gameOver = undo.gameOver;
+    s.winner = undo.winner;
+    s.pile.head = undo.pileHead;
+    s.pile.deckCount = undo.deckCount;
+    s.pile.discardCount = undo.discardCount;
+}
+
+void determinize(UNOState& s, int observer, UNORng& rng) {
+    // Pool every card the observer can't see
+    CardCode pool[kDeckSize];
+    int n = 0;
+    for (int p = 0; p < s.numPlayers; ++p) {
+        if (p == observer) continue;
+        const CardHand& hand = s.hands[p];
+        for (uint64_t bits = hand.present; bits; bits &= bits - 1) {
+            CardCode c = static_cast<CardCode>(__builtin_ctzll(bits));
+            for (int k = hand.copies(c); k > 0; --k) pool[n++] = c;
         }
-        return ss.str();
     }
+    for (int i = 0; i < s.pile.deckCount; ++i) pool[n++] = s.pile.cards[s.pile.at(i)];
+
+    rng.shuffle(pool, n);
+
+    // Deal it back out in the same shapes
+    int k = 0;
+    for (int p = 0; p < s.numPlayers; ++p) {
+        if (p == observer) continue;
+        CardHand& hand = s.hands[p];
+        int size = hand.size;
+        hand.clear();
+        for (int j = 0; j < size; ++j) hand.pushBack(pool[k++]);
+    }
+    for (int i = 0; i < s.pile.deckCount; ++i) s.pile.cards[s.pile.at(i)] = pool[k++];
+}
+
+void observerView(const UNOState& s, UNOState& view, UNORng& rng) {
+    view.copyFrom(s);
+    determinize(view, s.currentPlayer, rng);
+    view.rng.reseed(rng());
+}
 
+bool samePosition(const UNOState& a, const UNOState& b) {
+    if (!(a.rng == b.rng) || a.numPlayers != b.numPlayers || a.currentPlayer != b.currentPlayer ||
+        a.clockwise != b.clockwise || a.gameOver != b.gameOver || a.winner != b.winner ||
+        a.pile.deckCount != b.pile.deckCount || a.pile.discardCount != b.pile.discardCount) {
+        return false;
+    }
+    for (int i = 0; i < a.pile.deckCount + a.pile.discardCount; ++i) {
+        if (a.pile.cards[a.pile.at(i)] != b.pile.cards[b.pile.at(i)]) return false;
+    }
+    for (int p = 0; p < a.numPlayers; ++p) {
+        const CardHand& x = a.hands[p];
+        const CardHand& y = b.hands[p];
+        if (x.present != y.present || x.size != y.size ||
+            std::memcmp(x.order, y.order, sizeof(x.order)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string formatState(const UNOState& s) {
+    std::ostringstream ss;
+    ss << "Player " << static_cast<int>(s.currentPlayer) << "'s turn, Direction: "
+       << (s.clockwise ? "Clockwise" : "Counter-clockwise")
+       << ", Top: " << cardName(s.pile.top())
+       << ", Players cards: ";
+    for (int i = 0; i < s.numPlayers; ++i) {
+        ss << "P" << i << ":" << s.hands[i].getSize();
+        if (i < s.numPlayers - 1) ss << ", ";
+    }
+    return ss.str();
+}
+
+// -------------------------------
+// Concrete UNOGame implementation
+// -------------------------------
+class ConcreteUNOGame : public UNOGame {
 private:
-    // compute next index from idx by steps according to direction dir
-    int nextIndexFrom(int idx, int steps, bool dir) const {
-        if (numPlayers == 0) return 0;
-        int s = ((steps % numPlayers) + numPlayers) % numPlayers;
-        if (dir) { // clockwise
-            return (idx + s) % numPlayers;
+    UNOState st;        // the whole position, including the rng
+    UNOGameStats stats;
+    UNOStrategy* strategies[kMaxPlayers];
+    UNORng viewRng;     // resamples the hidden cards in what strategies see
+    uint64_t seed, stream;
+
+    // Strategy and view seeds come from this stream of the game's seed, so
+    // nothing a strategy is handed was ever drawn by the deal's generator
+    static const uint64_t kStrategyStream = 1ULL << 63;
+
+public:
+    ConcreteUNOGame(int n)
+        : UNOGame(n), seed(1234), stream(0)
+    {
+        st.rng.reseed(seed, stream); // seed deterministically once
+        st.numPlayers = static_cast<uint8_t>(std::min(std::max(n, 1), kMaxPlayers));
+        st.currentPlayer = 0;
+        st.clockwise = true;
+        st.gameOver = false;
+        st.winner = -1;
+        st.pile.clear();
+        for (int p = 0; p < st.numPlayers; ++p) st.hands[p].clear();
+        for (int p = 0; p < kMaxPlayers; ++p) strategies[p] = nullptr;
+    }
+
+    // Seeded variant: (seed, stream) picks one of 2^64 independent sequences
+    ConcreteUNOGame(int n, uint64_t gameSeed, uint64_t gameStream)
+        : ConcreteUNOGame(n)
+    {
+        seed = gameSeed;
+        stream = gameStream;
+        st.rng.reseed(seed, stream);
+    }
+
+    // Copies only the live part of the flat state
+    ConcreteUNOGame(const ConcreteUNOGame& other)
+        : UNOGame(other), stats(other.stats), viewRng(other.viewRng),
+          seed(other.seed), stream(other.stream)
+    {
+        st.copyFrom(other.st);
+        std::memcpy(strategies, other.strategies, sizeof(strategies));
+    }
+
+    ~ConcreteUNOGame() override = default;
+
+    void initialize() override {
+        stats = UNOGameStats();
+        // Per-game seed for the strategies and a second, unseen one for their
+        // views, both from the strategy stream
+        UNORng seeds(seed, stream ^ kStrategyStream);
+        uint64_t gameSeed = seeds();
+        viewRng.reseed(seeds(), kMaxPlayers);
+        for (int p = 0; p < st.numPlayers; ++p) {
+            if (strategies[p]) strategies[p]->newGame(p, gameSeed);
+        }
+        dealState(st);
+    }
+
+    void playTurn() override {
+        if (st.gameOver) return;
+        UNOMove move;
+        if (UNOStrategy* strategy = strategies[st.currentPlayer]) {
+            UNOMove legal[kMaxMoves];
+            int n = legalMoves(st, legal);
+            UNOState view;
+            observerView(st, view, viewRng);
+            move = strategy->chooseMove(view, legal, n);
+            if (!isLegalMove(st, move)) move = greedyMove(st);   // never apply a bad plug-in move
         } else {
-            int val = (idx - s) % numPlayers;
-            if (val < 0) val += numPlayers;
-            return val;
+            move = greedyMove(st);
         }
+        UNOUndo undo;
+        ::makeMove(st, move, undo, &stats);
+    }
+
+    bool isGameOver() const override { return st.gameOver; }
+    int getWinner() const override { return st.winner; }
+    const UNOGameStats& getStats() const override { return stats; }
+    std::string getState() const override { return formatState(st); }
+
+    std::unique_ptr<UNOGame> clone() const override {
+        return std::unique_ptr<UNOGame>(new ConcreteUNOGame(*this));
+    }
+    const UNOState& getPosition() const override { return st; }
+    int getLegalMoves(UNOMove out[kMaxMoves]) const override { return legalMoves(st, out); }
+    void makeMove(const UNOMove& move, UNOUndo& undo) override { ::makeMove(st, move, undo, &stats); }
+    void unmakeMove(const UNOUndo& undo) override { ::unmakeMove(st, undo); }
+
+    void setStrategy(int player, UNOStrategy* strategy) override {
+        if (player >= 0 && player < kMaxPlayers) strategies[player] = strategy;
     }
 };
 
@@ -460,3 +435,7 @@ private:
 std::unique_ptr<UNOGame> UNOGame::create(int numPlayers) {
     return std::make_unique<ConcreteUNOGame>(numPlayers);
 }
+
+std::unique_ptr<UNOGame> UNOGame::create(int numPlayers, uint64_t seed, uint64_t stream) {
+    return std::make_unique<ConcreteUNOGame>(numPlayers, seed, stream);
+}
@@ -4,6 +4,11 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <cstdint>
+#include "uno_cards.h"
+#include "uno_state.h"
+
+class UNOStrategy;
 
 // ------------------------------
 // Card Definition
@@ -31,36 +36,42 @@ struct Card {
         return !(*this == other);
     }
 
+    // Pack into the one-byte encoding (kNoCard for anything that isn't a real card)
+    CardCode code() const {
+        if (color == NONE) return kNoCard;
+        if (type != NUMBER) return cardCode(color, 9 + type);
+        return (number >= 0 && number <= 9) ? cardCode(color, number) : kNoCard;
+    }
+
+    static Card fromCode(CardCode c) {
+        if (!isCardCode(c)) return Card();
+        int kind = codeKind(c);
+        Color col = static_cast<Color>(codeColor(c));
+        return kind <= 9 ? Card(col, NUMBER, kind) : Card(col, static_cast<Type>(kind - 9), -1);
+    }
+
     // Check if two cards can match
     bool matches(const Card& other) const {
-        return (color == other.color) ||
-               (type == other.type && type != NUMBER) ||
-               (type == NUMBER && other.type == NUMBER && number == other.number);
+        return codesMatch(code(), other.code());
     }
 
     // Convert card to readable string like "Blue 5" or "Yellow Skip"
     std::string toString() const {
-        std::string colorStr, typeStr;
-
-        switch (color) {
-            case RED: colorStr = "Red"; break;
-            case GREEN: colorStr = "Green"; break;
-            case BLUE: colorStr = "Blue"; break;
-            case YELLOW: colorStr = "Yellow"; break;
-            default: colorStr = "None"; break;
-        }
-
-        switch (type) {
-            case NUMBER: typeStr = std::to_string(number); break;
-            case SKIP: typeStr = "Skip"; break;
-            case REVERSE: typeStr = "Reverse"; break;
-            case DRAW_TWO: typeStr = "Draw Two"; break;
-        }
-
-        return colorStr + " " + typeStr;
+        return cardName(code());
     }
 };
 
+// ------------------------------
+// Per-game statistics
+// ------------------------------
+struct UNOGameStats {
+    int turns;           // playTurn() calls that did something
+    int reshuffles;      // times the discard pile was recycled into the deck
+    int cardsPlayed[4];  // indexed by Card::Type
+
+    UNOGameStats() : turns(0), reshuffles(0), cardsPlayed{0, 0, 0, 0} {}
+};
+
 // ------------------------------
 // Abstract UNOGame Class
 // ------------------------------
@@ -75,9 +86,26 @@ public:
     virtual bool isGameOver() const = 0;
     virtual int getWinner() const = 0;
     virtual std::string getState() const = 0;
+    virtual const UNOGameStats& getStats() const = 0;
 
-    // Factory method (implemented in .cpp)
+    // Search support (see uno_state.h). The position is one flat UNOState,
+    // so clone() is a memcpy; makeMove/unmakeMove step it in place.
+    virtual std::unique_ptr<UNOGame> clone() const = 0;
+    virtual const UNOState& getPosition() const = 0;
+    virtual int getLegalMoves(UNOMove out[kMaxMoves]) const = 0;
+    virtual void makeMove(const UNOMove& move, UNOUndo& undo) = 0;
+    virtual void unmakeMove(const UNOUndo& undo) = 0;
+
+    // Policy playTurn() uses for one seat (see uno_strategy.h). Not owned and
+    // shared with clones; nullptr (the default) is the built-in greedy policy.
+    virtual void setStrategy(int player, UNOStrategy* strategy) = 0;
+
+    // Factory method (implemented in .cpp); numPlayers is clamped to 1..kMaxPlayers
     static std::unique_ptr<UNOGame> create(int numPlayers);
+
+    // Same as above, but shuffles with the given seed instead of the fixed 1234.
+    // Different streams of one seed are independent (see uno_rng.h).
+    static std::unique_ptr<UNOGame> create(int numPlayers, uint64_t seed, uint64_t stream = 0);
 };
 
 #endif // UNO_H
@@ -0,0 +1,235 @@
+// uno_batch.cpp
+#include "uno_batch.h"
+#include "uno_sim.h"
+#include "uno.h"
+#include "metrics.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+METRIC_COUNTER(batchReshuffles, "uno_batch_reshuffles_total", "Discard pile recycled into the deck (lane-batched engine)");
+
+} // namespace
+
+// Out-of-class definitions: std::min and the vector fill take these by reference
+const int UNOBatch::kMaxLanes;
+const uint32_t UNOBatch::kNoStamp;
+
+UNOBatch::UNOBatch(int n, uint64_t seed, int turnCap, int laneCount)
+    : numPlayers(std::min(std::max(n, 1), kMaxPlayers)),
+      lanes(std::min(std::max(laneCount, 1), kMaxLanes)),
+      maxTurns(turnCap),
+      baseSeed(seed),
+      stamps(static_cast<size_t>(lanes) * numPlayers * kHandSlots * 2, kNoStamp)
+{
+    std::memset(active, 0, sizeof(active));
+    std::memset(loaded, 0, sizeof(loaded));
+}
+
+void UNOBatch::run(const GameSource& source, UNOSimResults& out) {
+    uint64_t index;
+    for (int l = 0; l < lanes; ++l) {
+        if (source(index)) deal(l, index);
+    }
+
+    while (true) {
+        uint8_t any = 0;
+        for (int l = 0; l < lanes; ++l) any |= loaded[l];
+        if (!any) break;
+
+        step();
+
+        // Harvest finished lanes and refill them straight away
+        for (int l = 0; l < lanes; ++l) {
+            if (loaded[l] && !active[l]) {
+                harvest(l, out);
+                if (source(index)) deal(l, index);
+            }
+        }
+    }
+}
+
+// Deal through the scalar engine so the opening is identical by construction,
+// then scatter it into this lane
+void UNOBatch::deal(int l, uint64_t gameIndex) {
+    UNOState s;
+    s.rng.reseed(baseSeed, gameIndex);
+    s.numPlayers = static_cast<uint8_t>(numPlayers);
+    dealState(s);
+
+    for (int p = 0; p < numPlayers; ++p) {
+        const CardHand& hand = s.hands[p];
+        present[p][l] = hand.present;
+        handSize[p][l] = hand.size;
+        nextStamp[p][l] = hand.nextOrder;
+        uint32_t* o = &stamps[(static_cast<size_t>(l) * numPlayers + p) * kHandSlots * 2];
+        for (int slot = 0; slot < kHandSlots; ++slot) {
+            for (int k = 0; k < 2; ++k) {
+                uint8_t v = hand.order[slot][k];
+                o[slot * 2 + k] = v == CardHand::kEmpty ? kNoStamp : v;
+            }
+        }
+    }
+
+    std::memcpy(pile[l], s.pile.cards, sizeof(pile[l]));
+    head[l] = s.pile.head;
+    deckCount[l] = s.pile.deckCount;
+    discardCount[l] = s.pile.discardCount;
+    top[l] = s.pile.top();
+
+    current[l] = 0;
+    clockwise[l] = 1;
+    // The cap is tested before every turn, the first included, as in the
+    // scalar loop; a lane dealt under a zero cap is harvested unplayed
+    active[l] = maxTurns > 0;
+    loaded[l] = 1;
+    winner[l] = -1;
+    turns[l] = 0;
+    reshuffles[l] = 0;
+    for (int t = 0; t < 4; ++t) played[t][l] = 0;
+    rng[l] = s.rng;
+}
+
+void UNOBatch::harvest(int l, UNOSimResults& out) {
+    UNOGameStats st;
+    st.turns = turns[l];
+    st.reshuffles = reshuffles[l];
+    for (int t = 0; t < 4; ++t) st.cardsPlayed[t] = played[t][l];
+    out.record(winner[l] >= 0, winner[l], st);
+    loaded[l] = 0;
+}
+
+void UNOBatch::step() {
+    // Phase 1: match test for every lane at once. Straight-line and
+    // branch-free; finished lanes are masked to "no candidates".
+    for (int l = 0; l < lanes; ++l) {
+        uint64_t hand = present[current[l]][l];
+        uint64_t playable = hand & kMatchTable.mask[top[l]];
+        uint64_t sameColor = playable & colorBits(codeColor(top[l]) & 3);
+        uint64_t useColor = 0 - static_cast<uint64_t>(sameColor != 0);
+        uint64_t live = 0 - static_cast<uint64_t>(active[l]);
+        candidates[l] = ((sameColor & useColor) | (playable & ~useColor)) & live;
+    }
+
+    // Phase 2: resolve each running lane's turn. This is scalar per lane and
+    // branches on the lane's state; it mirrors makeMove() + greedyMove()
+    for (int l = 0; l < lanes; ++l) {
+        if (!active[l]) continue;
+        turns[l]++;
+        int p = current[l];
+
+        if (top[l] == kNoCard) {
+            current[l] = static_cast<uint8_t>(nextIndex(l, 1));
+        } else if (candidates[l]) {
+            // Oldest candidate wins, like CardHand::findPlayable
+            uint64_t c = candidates[l];
+            int best = __builtin_ctzll(c);
+            uint32_t bestStamp = stampsOf(l, p, static_cast<CardCode>(best))[0];
+            for (c &= c - 1; c; c &= c - 1) {
+                int k = __builtin_ctzll(c);
+                uint32_t stamp = stampsOf(l, p, static_cast<CardCode>(k))[0];
+                if (stamp < bestStamp) {
+                    best = k;
+                    bestStamp = stamp;
+                }
+            }
+            CardCode chosen = static_cast<CardCode>(best);
+            takeOldest(l, p, chosen);
+            discard(l, chosen);
+            if (handSize[p][l] == 0) {
+                active[l] = 0;
+                winner[l] = static_cast<int8_t>(p);
+            } else {
+                applyEffect(l, chosen);
+            }
+        } else {
+            CardCode before = top[l];
+            CardCode drawn = draw(l);
+            if (drawn == kNoCard) {
+                current[l] = static_cast<uint8_t>(nextIndex(l, 1));
+            } else if (codesMatch(before, drawn)) {
+                discard(l, drawn);
+                applyEffect(l, drawn);
+            } else {
+                give(l, p, drawn);
+                current[l] = static_cast<uint8_t>(nextIndex(l, 1));
+            }
+        }
+
+        if (turns[l] >= maxTurns) active[l] = 0;
+    }
+}
+
+int UNOBatch::nextIndex(int l, int steps) const {
+    int s = ((steps % numPlayers) + numPlayers) % numPlayers;
+    if (clockwise[l]) return (current[l] + s) % numPlayers;
+    int val = (current[l] - s) % numPlayers;
+    return val < 0 ? val + numPlayers : val;
+}
+
+void UNOBatch::give(int l, int p, CardCode c) {
+    uint32_t* o = stampsOf(l, p, c);
+    if (o[1] != kNoStamp) return;
+    o[o[0] == kNoStamp ? 0 : 1] = nextStamp[p][l]++;
+    present[p][l] |= 1ULL << c;
+    handSize[p][l]++;
+}
+
+void UNOBatch::takeOldest(int l, int p, CardCode c) {
+    uint32_t* o = stampsOf(l, p, c);
+    o[0] = o[1];
+    o[1] = kNoStamp;
+    if (o[0] == kNoStamp) present[p][l] &= ~(1ULL << c);
+    handSize[p][l]--;
+}
+
+// Same ring discipline as CardPile, including the rotate-then-shuffle reshuffle
+CardCode UNOBatch::draw(int l) {
+    if (deckCount[l] == 0 && discardCount[l] > 1) {
+        std::rotate(pile[l], pile[l] + head[l], pile[l] + kDeckSize);
+        head[l] = 0;
+        deckCount[l] = static_cast<uint8_t>(discardCount[l] - 1);
+        discardCount[l] = 1;
+        rng[l].shuffle(pile[l], deckCount[l]);
+        reshuffles[l]++;
+        METRIC_ADD(batchReshuffles, 1);
+    }
+    if (deckCount[l] == 0) return kNoCard;
+    CardCode c = pile[l][head[l]];
+    head[l] = static_cast<uint8_t>((head[l] + 1) % kDeckSize);
+    deckCount[l]--;
+    return c;
+}
+
+void UNOBatch::discard(int l, CardCode c) {
+    pile[l][(head[l] + deckCount[l] + discardCount[l]) % kDeckSize] = c;
+    discardCount[l]++;
+    top[l] = c;
+    int kind = codeKind(c);
+    played[kind <= 9 ? 0 : kind - 9][l]++;
+}
+
+void UNOBatch::applyEffect(int l, CardCode c) {
+    int kind = codeKind(c);
+    if (kind <= 9) {
+        current[l] = static_cast<uint8_t>(nextIndex(l, 1));
+    } else if (kind == kKindSkip) {
+        current[l] = static_cast<uint8_t>(nextIndex(l, 2));
+    } else if (kind == kKindReverse) {
+        if (numPlayers == 2) {
+            current[l] = static_cast<uint8_t>(nextIndex(l, 2));
+        } else {
+            clockwise[l] = !clockwise[l];
+            current[l] = static_cast<uint8_t>(nextIndex(l, 1));
+        }
+    } else {
+        int victim = nextIndex(l, 1);
+        for (int d = 0; d < 2; ++d) {
+            CardCode dc = draw(l);
+            if (dc == kNoCard) break;
+            give(l, victim, dc);
+        }
+        current[l] = static_cast<uint8_t>(nextIndex(l, 2));
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef UNO_BATCH_H
+#define UNO_BATCH_H
+
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include "uno_state.h"
+
+struct UNOSimResults;
+
+// ------------------------------
+// Lane-batched UNO engine
+// ------------------------------
+// Holds up to kMaxLanes games in structure-of-arrays form and advances all
+// of them one turn per step. Each step first runs the match test for every
+// lane at once (hand set AND match mask of the top card, colour mask select)
+// in one branch-free loop over the lane arrays. It then resolves the chosen
+// action lane by lane with ordinary branches: finished lanes are skipped,
+// and play, draw and card effects each take their own path. Only the match
+// test is lane-parallel, and its table and hand lookups are gathers, so the
+// gain over the scalar engine is modest (about 1.05-1.2x at -O2). A lane
+// whose game ends is harvested and dealt the next game from the source, so
+// the batch stays full until the source runs dry.
+//
+// Game k is dealt from stream k of the base seed and follows exactly the
+// rules of makeMove() + greedyMove(), so every game ends seed-for-seed the
+// same as UNOGame::create(numPlayers, baseSeed, k) driven by playTurn().
+class UNOBatch {
+public:
+    static const int kMaxLanes = 64;
+
+    // Supplies the next game index to deal; returns false when there are none
+    typedef std::function<bool(uint64_t& gameIndex)> GameSource;
+
+    UNOBatch(int numPlayers, uint64_t baseSeed, int maxTurns, int lanes);
+
+    // Play every game the source hands out and record each into `out`
+    void run(const GameSource& source, UNOSimResults& out);
+
+private:
+    static const uint32_t kNoStamp = 0xFFFFFFFFu;
+
+    int numPlayers;
+    int lanes;
+    int maxTurns;
+    uint64_t baseSeed;
+
+    // Per-lane game state (index [..][lane])
+    uint64_t present[kMaxPlayers][kMaxLanes];   // hand card sets
+    uint8_t handSize[kMaxPlayers][kMaxLanes];
+    uint32_t nextStamp[kMaxPlayers][kMaxLanes];
+    std::vector<uint32_t> stamps;               // [lane][player][slot][copy], oldest first
+    CardCode pile[kMaxLanes][kDeckSize];        // deck + discard ring, as in CardPile
+    uint8_t head[kMaxLanes];
+    uint8_t deckCount[kMaxLanes];
+    uint8_t discardCount[kMaxLanes];
+    CardCode top[kMaxLanes];
+    uint8_t current[kMaxLanes];
+    uint8_t clockwise[kMaxLanes];
+    uint8_t active[kMaxLanes];                  // 1 while the lane's game is running
+    uint8_t loaded[kMaxLanes];                  // 1 while the lane holds a game to harvest
+    int8_t winner[kMaxLanes];
+    int turns[kMaxLanes];
+    int reshuffles[kMaxLanes];
+    int played[4][kMaxLanes];
+    UNORng rng[kMaxLanes];
+
+    // Lane-parallel scratch for one step
+    uint64_t candidates[kMaxLanes];
+
+    uint32_t* stampsOf(int lane, int player, CardCode c) {
+        return &stamps[((static_cast<size_t>(lane) * numPlayers + player) * kHandSlots + handSlot(c)) * 2];
+    }
+
+    void deal(int lane, uint64_t gameIndex);
+    void harvest(int lane, UNOSimResults& out);
+    void step();
+
+    int nextIndex(int lane, int steps) const;
+    void give(int lane, int player, CardCode c);
+    void takeOldest(int lane, int player, CardCode c);
+    CardCode draw(int lane);
+    void discard(int lane, CardCode c);
+    void applyEffect(int lane, CardCode c);
+};
+
+#endif // UNO_BATCH_H
@@ -0,0 +1,56 @@
+#include "uno_sim.h"
+#include <iostream>
+
+using namespace std;
+
+static bool sameResults(const UNOSimResults& a, const UNOSimResults& b) {
+    for (int t = 0; t < 4; ++t) {
+        if (a.cardsPlayed[t] != b.cardsPlayed[t]) return false;
+    }
+    return a.gamesPlayed == b.gamesPlayed && a.unfinished == b.unfinished &&
+           a.wins == b.wins && a.lengthHistogram == b.lengthHistogram &&
+           a.totalTurns == b.totalTurns && a.totalReshuffles == b.totalReshuffles;
+}
+
+int main() {
+    UNOSimConfig cfg;
+    cfg.numPlayers = 3;
+    cfg.numGames = 50000;
+    cfg.baseSeed = 2024;
+    cfg.numThreads = 1;
+
+    // One game at a time
+    UNOSimResults scalar = UNOSimulator::run(cfg);
+    cout << "Scalar:   " << static_cast<long>(scalar.gamesPerSecond()) << " games/s" << endl;
+
+    // Same games, stepped in lockstep batches of different widths
+    const int widths[] = { 8, 16, 32, 64 };
+    bool allSame = true;
+    for (int lanes : widths) {
+        cfg.lanes = lanes;
+        UNOSimResults batched = UNOSimulator::run(cfg);
+        bool same = sameResults(scalar, batched);
+        allSame = allSame && same;
+        cout << "Lanes " << lanes << ": " << static_cast<long>(batched.gamesPerSecond())
+             << " games/s, identical to scalar: " << (same ? "yes" : "no") << endl;
+    }
+
+    // Turn caps, down to none at all, cut both engines off at the same turn
+    const int caps[] = { 0, 1, 7, 40 };
+    bool capsSame = true;
+    cfg.numGames = 2000;
+    for (int cap : caps) {
+        cfg.maxTurns = cap;
+        cfg.lanes = 0;
+        UNOSimResults one = UNOSimulator::run(cfg);
+        cfg.lanes = 16;
+        UNOSimResults many = UNOSimulator::run(cfg);
+        bool same = sameResults(one, many);
+        capsSame = capsSame && same;
+        cout << "maxTurns " << cap << ": " << one.unfinished << " unfinished, "
+             << one.totalTurns << " turns, identical to scalar: " << (same ? "yes" : "no") << endl;
+    }
+
+    cout << scalar.report() << endl;
+    return allSame && capsSame ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+#ifndef UNO_CARDS_H
+#define UNO_CARDS_H
+
+#include <cstdint>
+
+// ------------------------------
+// One-byte card encoding
+// ------------------------------
+// code = (color << 4) | kind, where kind 0-9 are the numbers and 10, 11, 12
+// are Skip, Reverse and Draw Two. Every real card therefore has a code below
+// 64, which lets a whole hand or a set of cards live in one uint64_t with
+// bit `code` standing for that card. Anything else (kNoCard) is "no card".
+typedef uint8_t CardCode;
+
+const CardCode kNoCard = 0xFF;
+const int kCardColors = 4;
+const int kCardKinds = 13;
+const int kCardCodeSpace = 64;
+const int kDeckSize = 100;  // no wild cards in this variant
+
+const int kKindSkip = 10;
+const int kKindReverse = 11;
+const int kKindDrawTwo = 12;
+
+constexpr CardCode cardCode(int color, int kind) {
+    return static_cast<CardCode>((color << 4) | kind);
+}
+constexpr int codeColor(CardCode c) { return c >> 4; }
+constexpr int codeKind(CardCode c) { return c & 15; }
+constexpr bool isCardCode(CardCode c) {
+    return codeColor(c) < kCardColors && codeKind(c) < kCardKinds;
+}
+
+// Bits of a 64-bit card set that belong to one colour
+constexpr uint64_t colorBits(int color) {
+    return static_cast<uint64_t>(0x1FFF) << (color * 16);
+}
+
+// Bits of a 64-bit card set that have one kind (any colour)
+constexpr uint64_t kindBits(int kind) {
+    return 0x0001000100010001ULL << kind;
+}
+
+// ------------------------------
+// Compile-time tables
+// ------------------------------
+
+// The 100-card deck in canonical (unshuffled) order: per colour one 0,
+// two of each 1-9, then two each of Skip, Reverse and Draw Two
+struct CardDeckTable {
+    CardCode cards[kDeckSize];
+};
+
+constexpr CardDeckTable buildCanonicalDeck() {
+    CardDeckTable t{};
+    int n = 0;
+    for (int c = 0; c < kCardColors; ++c) {
+        t.cards[n++] = cardCode(c, 0);
+        for (int v = 1; v <= 9; ++v) {
+            t.cards[n++] = cardCode(c, v);
+            t.cards[n++] = cardCode(c, v);
+        }
+        for (int k = kKindSkip; k <= kKindDrawTwo; ++k) {
+            t.cards[n++] = cardCode(c, k);
+            t.cards[n++] = cardCode(c, k);
+        }
+    }
+    return t;
+}
+
+constexpr CardDeckTable kCanonicalDeck = buildCanonicalDeck();
+static_assert(kCanonicalDeck.cards[kDeckSize - 1] == cardCode(3, kKindDrawTwo),
+              "canonical deck table must fill exactly kDeckSize cards");
+
+// kMatchTable.mask[a] has bit b set when card b may be played on top card a
+// (same colour, or same kind - which covers both equal numbers and equal
+// action types). Entries for codes that aren't cards are empty.
+struct CardMatchTable {
+    uint64_t mask[256];
+};
+
+constexpr CardMatchTable buildMatchTable() {
+    CardMatchTable t{};
+    for (int a = 0; a < 256; ++a) {
+        CardCode top = static_cast<CardCode>(a);
+        if (!isCardCode(top)) continue;
+        t.mask[a] = colorBits(codeColor(top)) | kindBits(codeKind(top));
+    }
+    return t;
+}
+
+constexpr CardMatchTable kMatchTable = buildMatchTable();
+
+constexpr bool codesMatch(CardCode top, CardCode card) {
+    return card < kCardCodeSpace && ((kMatchTable.mask[top] >> card) & 1);
+}
+
+// Display names, indexed by code (padding slots 13-15 of each colour unused)
+#define UNO_COLOR_NAMES(C) \
+    C " 0", C " 1", C " 2", C " 3", C " 4", C " 5", C " 6", C " 7", C " 8", C " 9", \
+    C " Skip", C " Reverse", C " Draw Two", "None -1", "None -1", "None -1"
+
+static const char* const kCardNames[kCardCodeSpace] = {
+    UNO_COLOR_NAMES("Red"), UNO_COLOR_NAMES("Green"),
+    UNO_COLOR_NAMES("Blue"), UNO_COLOR_NAMES("Yellow")
+};
+
+#undef UNO_COLOR_NAMES
+
+inline const char* cardName(CardCode c) {
+    return c < kCardCodeSpace ? kCardNames[c] : "None -1";
+}
+
+#endif // UNO_CARDS_H
@@ -0,0 +1,77 @@
+#include "uno.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// ------------------------------
+// Reference card rules
+// ------------------------------
+// The field-by-field Card logic the compile-time tables replaced
+bool referenceMatches(const Card& a, const Card& b) {
+    return (a.color == b.color) ||
+           (a.type == b.type && a.type != Card::NUMBER) ||
+           (a.type == Card::NUMBER && b.type == Card::NUMBER && a.number == b.number);
+}
+
+string referenceName(const Card& c) {
+    static const char* colors[] = { "Red", "Green", "Blue", "Yellow", "None" };
+    static const char* types[] = { "", "Skip", "Reverse", "Draw Two" };
+    return string(colors[c.color]) + " " + (c.type == Card::NUMBER ? to_string(c.number) : types[c.type]);
+}
+
+// The deck-building loop initialize() used before the constexpr table
+vector<Card> referenceDeck() {
+    vector<Card> deck;
+    const Card::Color colors[] = { Card::RED, Card::GREEN, Card::BLUE, Card::YELLOW };
+    for (Card::Color c : colors) {
+        deck.emplace_back(c, Card::NUMBER, 0);
+        for (int v = 1; v <= 9; ++v) {
+            deck.emplace_back(c, Card::NUMBER, v);
+            deck.emplace_back(c, Card::NUMBER, v);
+        }
+        for (Card::Type t : { Card::SKIP, Card::REVERSE, Card::DRAW_TWO }) {
+            deck.emplace_back(c, t, -1);
+            deck.emplace_back(c, t, -1);
+        }
+    }
+    return deck;
+}
+
+int main() {
+    // Every distinct real card
+    vector<Card> cards;
+    for (int c = 0; c < 4; ++c) {
+        for (int v = 0; v <= 9; ++v) cards.emplace_back(static_cast<Card::Color>(c), Card::NUMBER, v);
+        for (int t = Card::SKIP; t <= Card::DRAW_TWO; ++t) {
+            cards.emplace_back(static_cast<Card::Color>(c), static_cast<Card::Type>(t), -1);
+        }
+    }
+
+    int codeErrors = 0, nameErrors = 0, matchErrors = 0;
+    for (const Card& a : cards) {
+        if (!isCardCode(a.code()) || Card::fromCode(a.code()) != a) ++codeErrors;
+        if (a.toString() != referenceName(a)) ++nameErrors;
+        for (const Card& b : cards) {
+            if (a.matches(b) != referenceMatches(a, b)) ++matchErrors;
+        }
+    }
+    // Anything that isn't a real card has no code and plays on nothing
+    Card none;
+    Card badNumber(Card::RED, Card::NUMBER, 10);
+    if (none.code() != kNoCard || badNumber.code() != kNoCard || kMatchTable.mask[kNoCard] != 0) ++codeErrors;
+
+    vector<Card> deck = referenceDeck();
+    int deckErrors = deck.size() == static_cast<size_t>(kDeckSize) ? 0 : 1;
+    for (int i = 0; i < kDeckSize && !deckErrors; ++i) {
+        if (kCanonicalDeck.cards[i] != deck[i].code()) ++deckErrors;
+    }
+
+    cout << "Cards: " << cards.size() << ", code round trips: " << (codeErrors ? "FAILED" : "ok") << endl;
+    cout << "Names vs original toString: " << (nameErrors ? "FAILED" : "ok") << endl;
+    cout << "Match table vs original matches (" << cards.size() * cards.size() << " pairs): "
+         << (matchErrors ? "FAILED" : "ok") << endl;
+    cout << "Canonical deck vs original build order: " << (deckErrors ? "FAILED" : "ok") << endl;
+    return codeErrors + nameErrors + matchErrors + deckErrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+#include "uno_state.h"
+#include <iostream>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+// ------------------------------
+// Reference hand
+// ------------------------------
+// The original linked-list hand: cards in the order they were added, the
+// first matching node removed, and the priority scan run over the list
+struct ListHand {
+    vector<CardCode> cards;
+
+    int copies(CardCode c) const { return static_cast<int>(count(cards.begin(), cards.end(), c)); }
+
+    void pushBack(CardCode c) {
+        if (copies(c) < 2) cards.push_back(c);
+    }
+
+    void removeCard(CardCode c) {
+        auto it = find(cards.begin(), cards.end(), c);
+        if (it != cards.end()) cards.erase(it);
+    }
+
+    // 1) colour match, 2) number match, 3) Skip, Reverse, Draw Two, each
+    // taking the first card encountered
+    bool findPlayable(CardCode top, CardCode& chosen) const {
+        vector<CardCode> playable;
+        for (CardCode c : cards) {
+            if (codesMatch(top, c)) playable.push_back(c);
+        }
+        if (playable.empty()) return false;
+        for (CardCode c : playable) {
+            if (codeColor(c) == codeColor(top)) { chosen = c; return true; }
+        }
+        for (CardCode c : playable) {
+            if (codeKind(c) <= 9 && codeKind(top) <= 9 && codeKind(c) == codeKind(top)) { chosen = c; return true; }
+        }
+        for (int kind : { kKindSkip, kKindReverse, kKindDrawTwo }) {
+            for (CardCode c : playable) {
+                if (codeKind(c) == kind) { chosen = c; return true; }
+            }
+        }
+        chosen = playable[0];
+        return true;
+    }
+};
+
+int main() {
+    UNORng rng(27);
+    long checks = 0, mismatches = 0, renumbers = 0;
+
+    for (int round = 0; round < 200; ++round) {
+        CardHand hand;
+        hand.clear();
+        ListHand ref;
+        // Small hands churned for a long time, so the stamps wrap many times
+        int target = 1 + static_cast<int>(rng.bounded(20));
+
+        for (int step = 0; step < 2000; ++step) {
+            CardCode c = kCanonicalDeck.cards[rng.bounded(kDeckSize)];
+            if (hand.getSize() < target || rng.bounded(2) == 0) {
+                uint8_t before = hand.nextOrder;
+                int size = hand.getSize();
+                hand.pushBack(c);
+                ref.pushBack(c);
+                // A push that added a card without stepping the stamp on by one renumbered
+                if (hand.getSize() > size && hand.nextOrder != before + 1) ++renumbers;
+            } else if (!ref.cards.empty()) {
+                CardCode held = ref.cards[rng.bounded(static_cast<uint32_t>(ref.cards.size()))];
+                hand.removeCard(held);
+                ref.removeCard(held);
+            }
+
+            CardCode top = kCanonicalDeck.cards[rng.bounded(kDeckSize)];
+            CardCode got = kNoCard, want = kNoCard;
+            bool gotAny = hand.findPlayable(top, got);
+            bool wantAny = ref.findPlayable(top, want);
+            ++checks;
+            if (gotAny != wantAny || got != want || hand.getSize() != static_cast<int>(ref.cards.size()) ||
+                hand.copies(c) != ref.copies(c)) {
+                ++mismatches;
+            }
+        }
+    }
+
+    cout << "Random hands: " << checks << " choices checked against a list scan, "
+         << renumbers << " stamp renumbers, " << mismatches << " mismatches" << endl;
+    return mismatches == 0 && renumbers > 0 ? 0 : 1;
+}
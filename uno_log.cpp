@@ -0,0 +1,371 @@
+// uno_log.cpp
+#include "uno_log.h"
+#include "uno.h"
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const char kMagic[8] = { 'U', 'N', 'O', 'L', 'O', 'G', '3', '\0' };
+
+// What the move just applied did, as far as the log cares
+UNOEvent describe(int player, const UNOMove& move, const UNOUndo& undo) {
+    UNOEvent e;
+    e.player = static_cast<uint8_t>(player);
+    e.victimDrew = 0;
+    if (move.kind == UNOMove::PLAY) {
+        e.action = UNOEvent::PLAY;
+        e.card = move.card;
+        e.victimDrew = undo.numPushed;
+    } else if (undo.drawn == kNoCard) {
+        e.action = UNOEvent::PASS;
+        e.card = kNoCard;
+    } else if (undo.drawnPlayed) {
+        e.action = UNOEvent::DRAW_PLAY;
+        e.card = undo.drawn;
+        e.victimDrew = undo.numPushed;
+    } else {
+        e.action = UNOEvent::DRAW_KEEP;
+        e.card = undo.drawn;
+    }
+    return e;
+}
+
+// Keyframe sanity check for load(): every field that indexes an array in
+// makeMove() or formatState() is in range, the hands are self-consistent
+// and each hand's stamps are distinct, oldest first and below its nextOrder
+bool plausibleState(const UNOState& s, int numPlayers) {
+    if (s.numPlayers != numPlayers || s.currentPlayer >= numPlayers) return false;
+    if (s.winner < -1 || s.winner >= numPlayers || s.gameOver != (s.winner >= 0)) return false;
+    const CardPile& pile = s.pile;
+    if (pile.head >= kDeckSize || pile.deckCount + pile.discardCount > kDeckSize) return false;
+    for (int i = 0; i < pile.deckCount + pile.discardCount; ++i) {
+        if (!isCardCode(pile.cards[pile.at(i)])) return false;
+    }
+    int cards = pile.deckCount + pile.discardCount;
+    for (int p = 0; p < numPlayers; ++p) {
+        const CardHand& h = s.hands[p];
+        bool stamped[256] = {};
+        int copies = 0;
+        for (int c = 0; c < kCardCodeSpace; ++c) {
+            bool held = (h.present >> c) & 1;
+            if (!isCardCode(static_cast<CardCode>(c))) {
+                if (held) return false;
+                continue;
+            }
+            const uint8_t* o = h.order[handSlot(static_cast<CardCode>(c))];
+            if (held != (o[0] != CardHand::kEmpty)) return false;
+            if (o[1] != CardHand::kEmpty && o[1] <= o[0]) return false;  // also rejects o[0] empty
+            for (int k = 0; k < 2 && o[k] != CardHand::kEmpty; ++k) {
+                if (o[k] >= h.nextOrder || stamped[o[k]]) return false;
+                stamped[o[k]] = true;
+                ++copies;
+            }
+        }
+        if (copies != h.size) return false;
+        cards += copies;
+    }
+    return cards == kDeckSize;
+}
+
+// ------------------------------
+// Keyframe packing
+// ------------------------------
+const uint8_t kDealtFrame = 0;     // seed, stream
+const uint8_t kPositionFrame = 1;  // the live fields of a UNOState
+const uint64_t kMinKeyframeBytes = 1 + 8 + 8;
+
+void put64(std::vector<uint8_t>& out, uint64_t v) {
+    for (int i = 0; i < 8; ++i) out.push_back(static_cast<uint8_t>(v >> (8 * i)));
+}
+
+void packDealt(std::vector<uint8_t>& out, uint64_t seed, uint64_t stream) {
+    out.push_back(kDealtFrame);
+    put64(out, seed);
+    put64(out, stream);
+}
+
+void packPosition(std::vector<uint8_t>& out, const UNOState& s) {
+    out.push_back(kPositionFrame);
+    put64(out, s.rng.position());
+    put64(out, s.rng.increment());
+    out.push_back(s.currentPlayer);
+    out.push_back(s.clockwise);
+    out.push_back(s.gameOver);
+    out.push_back(static_cast<uint8_t>(s.winner));
+    out.push_back(s.pile.deckCount);
+    out.push_back(s.pile.discardCount);
+    for (int i = 0; i < s.pile.deckCount + s.pile.discardCount; ++i) out.push_back(s.pile.cards[s.pile.at(i)]);
+    for (int p = 0; p < s.numPlayers; ++p) {
+        const CardHand& h = s.hands[p];
+        put64(out, h.present);
+        out.push_back(h.nextOrder);
+        for (uint64_t bits = h.present; bits; bits &= bits - 1) {
+            const uint8_t* o = h.order[handSlot(static_cast<CardCode>(__builtin_ctzll(bits)))];
+            out.push_back(o[0]);
+            out.push_back(o[1]);
+        }
+    }
+}
+
+// Bounds-checked little-endian reads over one keyframe
+struct FrameReader {
+    const uint8_t* at;
+    const uint8_t* end;
+
+    bool byte(uint8_t& v) {
+        if (at == end) return false;
+        v = *at++;
+        return true;
+    }
+    bool word(uint64_t& v) {
+        if (end - at < 8) return false;
+        v = 0;
+        for (int i = 0; i < 8; ++i) v |= static_cast<uint64_t>(at[i]) << (8 * i);
+        at += 8;
+        return true;
+    }
+};
+
+// Rebuild the position a keyframe holds; false when it runs past the end or
+// holds values no game produces
+bool unpack(FrameReader& in, int numPlayers, UNOState& s) {
+    uint8_t kind;
+    uint64_t a, b;
+    if (!in.byte(kind) || !in.word(a) || !in.word(b)) return false;
+    s.numPlayers = static_cast<uint8_t>(numPlayers);
+    if (kind == kDealtFrame) {
+        s.rng.reseed(a, b);
+        dealState(s);
+        return true;
+    }
+    if (kind != kPositionFrame || !s.rng.restore(a, b)) return false;
+
+    uint8_t clockwise, gameOver, winner, deckCount, discardCount;
+    if (!in.byte(s.currentPlayer) || !in.byte(clockwise) || !in.byte(gameOver) || !in.byte(winner) ||
+        !in.byte(deckCount) || !in.byte(discardCount)) {
+        return false;
+    }
+    // Read as bytes and checked before they become bools
+    if (clockwise > 1 || gameOver > 1 || deckCount + discardCount > kDeckSize) return false;
+    s.clockwise = clockwise != 0;
+    s.gameOver = gameOver != 0;
+    s.winner = static_cast<int8_t>(winner);
+
+    std::memset(s.pile.cards, kNoCard, sizeof(s.pile.cards));
+    s.pile.head = 0;
+    s.pile.deckCount = deckCount;
+    s.pile.discardCount = discardCount;
+    for (int i = 0; i < deckCount + discardCount; ++i) {
+        if (!in.byte(s.pile.cards[i])) return false;
+    }
+    for (int p = 0; p < numPlayers; ++p) {
+        CardHand& h = s.hands[p];
+        h.clear();
+        uint64_t present;
+        if (!in.word(present) || !in.byte(h.nextOrder)) return false;
+        h.present = present;
+        for (uint64_t bits = present; bits; bits &= bits - 1) {
+            CardCode c = static_cast<CardCode>(__builtin_ctzll(bits));
+            if (!isCardCode(c)) return false;
+            uint8_t* o = h.order[handSlot(c)];
+            if (!in.byte(o[0]) || !in.byte(o[1])) return false;
+            h.size = static_cast<uint8_t>(h.size + (o[0] != CardHand::kEmpty) + (o[1] != CardHand::kEmpty));
+        }
+    }
+    return true;
+}
+
+template <class T>
+void writeRaw(std::ofstream& out, const T& v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(v));
+}
+
+template <class T>
+bool readRaw(std::ifstream& in, T& v) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&v), sizeof(v)));
+}
+
+} // namespace
+
+UNOGameLog::UNOGameLog(int n, int interval)
+    : numPlayers(std::min(std::max(n, 1), kMaxPlayers)),
+      keyframeInterval(std::max(interval, 1)) {}
+
+void UNOGameLog::beginGame(const UNOState& start) {
+    GameIndex g;
+    g.firstEvent = events.size() / UNOEvent::kBytes;
+    g.firstKeyframe = keyframeAt.size();
+    g.turns = 0;
+    games.push_back(g);
+    keyframeIfDue(start);
+}
+
+void UNOGameLog::beginGame(const UNOState& start, uint64_t seed, uint64_t stream) {
+    UNOState dealt;
+    dealt.rng.reseed(seed, stream);
+    dealt.numPlayers = static_cast<uint8_t>(numPlayers);
+    dealState(dealt);
+    if (start.numPlayers != numPlayers || !samePosition(start, dealt)) {
+        beginGame(start);
+        return;
+    }
+    GameIndex g;
+    g.firstEvent = events.size() / UNOEvent::kBytes;
+    g.firstKeyframe = keyframeAt.size();
+    g.turns = 0;
+    games.push_back(g);
+    keyframeAt.push_back(keyframes.size());
+    packDealt(keyframes, seed, stream);
+}
+
+// Called with the position before turn games.back().turns
+void UNOGameLog::keyframeIfDue(const UNOState& s) {
+    if (games.back().turns % keyframeInterval != 0) return;
+    keyframeAt.push_back(keyframes.size());
+    packPosition(keyframes, s);
+}
+
+// Keyframe k is trusted here: recorded by this log or checked by load()
+bool UNOGameLog::readKeyframe(uint64_t k, UNOState& out) const {
+    uint64_t end = k + 1 < keyframeAt.size() ? keyframeAt[k + 1] : keyframes.size();
+    FrameReader in = { keyframes.data() + keyframeAt[k], keyframes.data() + end };
+    return unpack(in, numPlayers, out);
+}
+
+void UNOGameLog::append(const UNOEvent& e) {
+    uint8_t bytes[UNOEvent::kBytes];
+    e.encode(bytes);
+    events.insert(events.end(), bytes, bytes + UNOEvent::kBytes);
+    games.back().turns++;
+}
+
+void UNOGameLog::playTurn(UNOState& s, const UNOMove& move, UNOGameStats* stats) {
+    if (s.gameOver) return;
+    int player = s.currentPlayer;
+    UNOUndo undo;
+    makeMove(s, move, undo, stats);
+    append(describe(player, move, undo));
+    keyframeIfDue(s);
+}
+
+void UNOGameLog::playTurn(UNOGame& game, const UNOMove& move) {
+    if (game.isGameOver()) return;
+    int player = game.getPosition().currentPlayer;
+    UNOUndo undo;
+    game.makeMove(move, undo);
+    append(describe(player, move, undo));
+    keyframeIfDue(game.getPosition());
+}
+
+UNOEvent UNOGameLog::event(size_t game, int turn) const {
+    return UNOEvent::decode(&events[(games[game].firstEvent + turn) * UNOEvent::kBytes]);
+}
+
+bool UNOGameLog::seek(size_t game, int turn, UNOState& out) const {
+    if (game >= games.size()) return false;
+    const GameIndex& g = games[game];
+    if (turn < 0 || turn > static_cast<int>(g.turns)) return false;
+
+    // Keyframes exist for turns 0, K, 2K, ... up to and including the length
+    int k = turn / keyframeInterval;
+    if (!readKeyframe(g.firstKeyframe + k, out)) return false;
+
+    for (int t = k * keyframeInterval; t < turn; ++t) {
+        UNOMove move = event(game, t).toMove();
+        if (!isLegalMove(out, move)) return false;
+        UNOUndo undo;
+        makeMove(out, move, undo);
+    }
+    return true;
+}
+
+std::string UNOGameLog::getState(size_t game, int turn) const {
+    UNOState s;
+    if (!seek(game, turn, s)) return std::string();
+    return formatState(s);
+}
+
+bool UNOGameLog::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary);
+    if (!out) return false;
+    out.write(kMagic, sizeof(kMagic));
+    writeRaw(out, static_cast<uint32_t>(numPlayers));
+    writeRaw(out, static_cast<uint32_t>(keyframeInterval));
+    writeRaw(out, static_cast<uint64_t>(games.size()));
+    writeRaw(out, static_cast<uint64_t>(events.size()));
+    writeRaw(out, static_cast<uint64_t>(keyframes.size()));
+    for (const GameIndex& g : games) {
+        writeRaw(out, g.firstEvent);
+        writeRaw(out, g.firstKeyframe);
+        writeRaw(out, g.turns);
+    }
+    out.write(reinterpret_cast<const char*>(events.data()), events.size());
+    out.write(reinterpret_cast<const char*>(keyframes.data()), keyframes.size());
+    return static_cast<bool>(out);
+}
+
+bool UNOGameLog::load(const std::string& path, UNOGameLog& out) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(kMagic)];
+    uint32_t players, interval;
+    uint64_t gameCount, eventCount, keyframeCount;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) return false;
+    if (!readRaw(in, players) || !readRaw(in, interval) ||
+        !readRaw(in, gameCount) || !readRaw(in, eventCount) || !readRaw(in, keyframeCount)) {
+        return false;
+    }
+    if (players < 1 || players > static_cast<uint32_t>(kMaxPlayers)) return false;
+    if (interval < 1 || interval > 0x7FFFFFFFu) return false;
+
+    UNOGameLog log(static_cast<int>(players), static_cast<int>(interval));
+
+    // The three tables must fill the rest of the file exactly; checked before
+    // anything is allocated, so a corrupt count can't ask for a huge buffer
+    std::streamoff here = in.tellg();
+    in.seekg(0, std::ios::end);
+    uint64_t remaining = static_cast<uint64_t>(in.tellg() - here);
+    in.seekg(here);
+    if (gameCount > remaining / kIndexBytes) return false;
+    uint64_t indexBytes = gameCount * kIndexBytes;
+    if (eventCount > remaining - indexBytes || keyframeCount != remaining - indexBytes - eventCount) return false;
+    if (eventCount % UNOEvent::kBytes != 0) return false;
+
+    // Games are stored back to back: each one starts where the last ended and
+    // owns turns / K + 1 keyframes
+    uint64_t nextEvent = 0, nextKeyframe = 0;
+    log.games.resize(gameCount);
+    for (GameIndex& g : log.games) {
+        if (!readRaw(in, g.firstEvent) || !readRaw(in, g.firstKeyframe) || !readRaw(in, g.turns)) return false;
+        if (g.firstEvent != nextEvent || g.firstKeyframe != nextKeyframe) return false;
+        nextEvent += g.turns;
+        nextKeyframe += g.turns / interval + 1;
+    }
+    if (nextEvent * UNOEvent::kBytes != eventCount || nextKeyframe > keyframeCount / kMinKeyframeBytes) return false;
+
+    log.events.resize(eventCount);
+    log.keyframes.resize(keyframeCount);
+    in.read(reinterpret_cast<char*>(log.events.data()), eventCount);
+    in.read(reinterpret_cast<char*>(log.keyframes.data()), keyframeCount);
+    if (!in) return false;
+
+    // Keyframes vary in length, so walk them in order; each must unpack to a
+    // plausible position and together they must end exactly at the end.
+    // Only a game's first keyframe may be a bare seed and stream.
+    log.keyframeAt.resize(nextKeyframe);
+    const uint8_t* base = log.keyframes.data();
+    FrameReader frames = { base, base + keyframeCount };
+    size_t game = 0;
+    for (uint64_t k = 0; k < nextKeyframe; ++k) {
+        while (game + 1 < log.games.size() && log.games[game + 1].firstKeyframe <= k) ++game;
+        log.keyframeAt[k] = static_cast<uint64_t>(frames.at - base);
+        if (frames.at != frames.end && *frames.at == kDealtFrame && k != log.games[game].firstKeyframe) return false;
+        UNOState s;
+        if (!unpack(frames, log.numPlayers, s) || !plausibleState(s, log.numPlayers)) return false;
+    }
+    if (frames.at != frames.end) return false;
+
+    out = std::move(log);
+    return true;
+}
@@ -0,0 +1,126 @@
+#ifndef UNO_LOG_H
+#define UNO_LOG_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "uno_state.h"
+
+class UNOGame;
+struct UNOGameStats;
+
+// ------------------------------
+// One logged turn
+// ------------------------------
+// Stored as two bytes: [player:4 | action:2 | victimDrew:2] [card]
+struct UNOEvent {
+    enum Action : uint8_t {
+        PLAY,        // played `card` from hand
+        DRAW_PLAY,   // drew `card`, it matched and was played
+        DRAW_KEEP,   // drew `card` and kept it
+        PASS         // nothing to play and nothing left to draw
+    };
+
+    uint8_t player;
+    uint8_t action;
+    uint8_t victimDrew;  // cards the next player drew because of a Draw Two (0-2)
+    CardCode card;       // kNoCard for PASS
+
+    static const int kBytes = 2;
+
+    void encode(uint8_t* out) const {
+        out[0] = static_cast<uint8_t>((player & 15) | (action << 4) | (victimDrew << 6));
+        out[1] = card;
+    }
+
+    static UNOEvent decode(const uint8_t* in) {
+        UNOEvent e;
+        e.player = in[0] & 15;
+        e.action = (in[0] >> 4) & 3;
+        e.victimDrew = in[0] >> 6;
+        e.card = in[1];
+        return e;
+    }
+
+    // The move that reproduces this turn
+    UNOMove toMove() const {
+        return action == PLAY ? UNOMove::play(card) : UNOMove::draw();
+    }
+};
+
+// ------------------------------
+// Binary game log with keyframes
+// ------------------------------
+// Records any number of games as a flat stream of 2-byte events, plus a
+// keyframe of the position before turns 0, K, 2K, ... (K = keyframeInterval,
+// including the final position when the game length is a multiple of K).
+// Reading turn t of game g rebuilds the keyframe for turn t - t % K and
+// replays at most K - 1 events through makeMove(), so any position can be
+// rebuilt (and printed like getState()) without replaying the whole game.
+//
+// A keyframe packs only the live fields, little-endian: the generator's two
+// words, the turn/direction/winner bytes, the deck and discard run, and per
+// hand its card set, next stamp and the stamps of the cards it holds - about
+// a third of a raw UNOState. A game started from a known deal stores just
+// its seed and stream for turn 0, since dealState() rebuilds the rest.
+class UNOGameLog {
+public:
+    explicit UNOGameLog(int numPlayers, int keyframeInterval = 32);
+
+    // ---- Recording ----
+    // Start a new game from an arbitrary position (kept as a full keyframe)
+    void beginGame(const UNOState& start);
+
+    // Start a new game dealt from (seed, stream), as UNOGame::create(n, seed,
+    // stream) deals it; turn 0 is stored as the seed and stream alone. Falls
+    // back to a full keyframe if `start` is not that deal.
+    void beginGame(const UNOState& start, uint64_t seed, uint64_t stream);
+
+    // Apply `move` to `s` (or to `game`) and log the turn
+    void playTurn(UNOState& s, const UNOMove& move, UNOGameStats* stats = nullptr);
+    void playTurn(UNOGame& game, const UNOMove& move);
+
+    // ---- Reading ----
+    size_t gameCount() const { return games.size(); }
+    int turnCount(size_t game) const { return static_cast<int>(games[game].turns); }
+    UNOEvent event(size_t game, int turn) const;
+
+    // Position before `turn` of `game` (turn == turnCount() gives the final
+    // position); false if out of range or a replayed event is not legal
+    bool seek(size_t game, int turn, UNOState& out) const;
+
+    // getState() text for that position
+    std::string getState(size_t game, int turn) const;
+
+    // ---- Size / persistence ----
+    size_t eventBytes() const { return events.size(); }
+    size_t keyframeBytes() const { return keyframes.size(); }
+
+    // load() rejects files whose sizes, game index or keyframes don't add up,
+    // including keyframes whose fields are out of range or inconsistent.
+    bool save(const std::string& path) const;
+    static bool load(const std::string& path, UNOGameLog& out);
+
+private:
+    struct GameIndex {
+        uint64_t firstEvent;     // index into events, in events (not bytes)
+        uint64_t firstKeyframe;  // index into keyframeAt, in keyframes
+        uint32_t turns;
+    };
+
+    int numPlayers;
+    int keyframeInterval;
+    std::vector<uint8_t> events;
+    std::vector<uint8_t> keyframes;   // packed keyframes, back to back
+    std::vector<uint64_t> keyframeAt; // byte offset of each keyframe (not saved)
+    std::vector<GameIndex> games;
+
+    // On disk: firstEvent, firstKeyframe, turns, no padding
+    static const int kIndexBytes = 8 + 8 + 4;
+
+    void keyframeIfDue(const UNOState& s);
+    bool readKeyframe(uint64_t k, UNOState& out) const;
+    void append(const UNOEvent& e);
+};
+
+#endif // UNO_LOG_H
@@ -0,0 +1,111 @@
+#include "uno.h"
+#include "uno_log.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <cstddef>
+
+using namespace std;
+
+int main() {
+    const int kGames = 200;
+    const int kInterval = 32;
+    UNOGameLog log(3, kInterval);
+
+    // Record games, remembering what getState() printed before every turn
+    vector<vector<string>> seen(kGames);
+    long turns = 0;
+    for (int g = 0; g < kGames; ++g) {
+        auto game = UNOGame::create(3, 77, g);
+        game->initialize();
+        // Game 0 keeps its whole dealt position; the rest store seed and stream
+        if (g == 0) log.beginGame(game->getPosition());
+        else log.beginGame(game->getPosition(), 77, g);
+        while (!game->isGameOver() && log.turnCount(g) < 5000) {
+            seen[g].push_back(game->getState());
+            log.playTurn(*game, greedyMove(game->getPosition()));
+            ++turns;
+        }
+        seen[g].push_back(game->getState());
+    }
+
+    cout << "Games: " << log.gameCount() << ", turns: " << turns << endl;
+    cout << "Event bytes: " << log.eventBytes() << " ("
+         << static_cast<double>(log.eventBytes()) / turns << " per turn)" << endl;
+    size_t keyframeCount = 0;
+    for (int g = 0; g < kGames; ++g) keyframeCount += log.turnCount(g) / kInterval + 1;
+    cout << "Keyframe bytes: " << log.keyframeBytes() << " (one every " << kInterval << " turns, "
+         << log.keyframeBytes() / keyframeCount << " bytes each on average; a raw 3-player UNOState is "
+         << offsetof(UNOState, hands) + 3 * sizeof(CardHand) << ")" << endl;
+
+    // Every position can be rebuilt from the log
+    bool seekOk = true;
+    for (int g = 0; g < kGames && seekOk; ++g) {
+        for (int t = 0; t <= log.turnCount(g) && seekOk; ++t) {
+            seekOk = log.getState(g, t) == seen[g][t];
+        }
+    }
+    cout << "Seek to every turn: " << (seekOk ? "ok" : "FAILED") << endl;
+
+    // First few turns of the first game, decoded
+    static const char* actions[] = { "plays", "draws and plays", "draws", "passes" };
+    for (int t = 0; t < 5 && t < log.turnCount(0); ++t) {
+        UNOEvent e = log.event(0, t);
+        cout << "  Player " << int(e.player) << " " << actions[e.action];
+        if (e.card != kNoCard) cout << " " << cardName(e.card);
+        if (e.victimDrew) cout << " (next player draws " << int(e.victimDrew) << ")";
+        cout << endl;
+    }
+
+    // Save / load round trip
+    const char* path = "uno_log_test.bin";
+    UNOGameLog loaded(2);
+    bool fileOk = log.save(path) && UNOGameLog::load(path, loaded) &&
+                  loaded.gameCount() == log.gameCount();
+    for (int g = 0; g < kGames && fileOk; ++g) {
+        int last = log.turnCount(g);
+        fileOk = loaded.getState(g, last) == seen[g][last] &&
+                 loaded.getState(g, last / 2) == seen[g][last / 2];
+    }
+    cout << "Save / load: " << (fileOk ? "ok" : "FAILED") << endl;
+
+    // Truncated or corrupted files are rejected rather than read past the end
+    vector<char> bytes;
+    {
+        ifstream in(path, ios::binary);
+        bytes.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    }
+    auto loads = [&](const vector<char>& b) {
+        { ofstream out(path, ios::binary); out.write(b.data(), b.size()); }
+        UNOGameLog l(2);
+        return UNOGameLog::load(path, l);
+    };
+    vector<char> truncated(bytes.begin(), bytes.end() - 1);
+    vector<char> hugeCount = bytes;
+    hugeCount[16 + 7] = 0x7F;          // top byte of the game count
+    vector<char> badIndex = bytes;
+    badIndex[40 + 20 + 3] ^= 0x10;     // second game's firstEvent
+    bool rejectOk = !loads(truncated) && !loads(hugeCount) && !loads(badIndex) && loads(bytes);
+
+    // Game 0's first keyframe is a full position: [kind] [rng 16] [player]
+    // [clockwise] [gameOver] [winner] [deck] [discard] [cards...] then per
+    // hand [present 8] [nextOrder] [stamp pairs...]
+    size_t frame = bytes.size() - log.keyframeBytes();
+    UNOState dealt;
+    log.seek(0, 0, dealt);
+    size_t hand0 = frame + 23 + dealt.pile.deckCount + dealt.pile.discardCount;
+    vector<char> badKind = bytes, badClockwise = bytes, badGameOver = bytes, badNextOrder = bytes;
+    badKind[frame] = 7;
+    badClockwise[frame + 18] = 2;
+    badGameOver[frame + 19] = 2;
+    badNextOrder[hand0 + 8] = 3;       // below stamps the hand already holds
+    rejectOk = rejectOk && !loads(badKind) && !loads(badClockwise) && !loads(badGameOver) &&
+               !loads(badNextOrder);
+    remove(path);
+    cout << "Corrupt files rejected: " << (rejectOk ? "ok" : "FAILED") << endl;
+
+    return seekOk && fileOk && rejectOk ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+#include "uno.h"
+#include <iostream>
+#include <vector>
+#include <new>
+#include <cstdlib>
+
+using namespace std;
+
+// ------------------------------
+// Allocation counter
+// ------------------------------
+static long allocations = 0;
+
+void* operator new(size_t n) {
+    ++allocations;
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+// ------------------------------
+// Reference piles
+// ------------------------------
+// Deck and discard as two separate lists: draw from the front of the deck,
+// discard onto the back, and recycle every discard but the top into a
+// freshly shuffled deck
+struct ListPiles {
+    vector<CardCode> deck, discard;
+
+    CardCode draw() {
+        if (deck.empty()) return kNoCard;
+        CardCode c = deck.front();
+        deck.erase(deck.begin());
+        return c;
+    }
+
+    bool recycle(UNORng& rng) {
+        if (!deck.empty() || discard.size() < 2) return false;
+        deck.assign(discard.begin(), discard.end() - 1);
+        discard.erase(discard.begin(), discard.end() - 1);
+        rng.shuffle(deck.data(), static_cast<int>(deck.size()));
+        return true;
+    }
+};
+
+// FNV-1a over a game's getState() after every turn
+static uint64_t transcriptHash(uint64_t seed, uint64_t stream, int players) {
+    uint64_t h = 0xcbf29ce484222325ULL;
+    auto mix = [&h](const string& s) {
+        for (unsigned char ch : s) h = (h ^ ch) * 0x100000001b3ULL;
+    };
+    auto game = UNOGame::create(players, seed, stream);
+    game->initialize();
+    mix(game->getState());
+    while (!game->isGameOver() && game->getStats().turns < 5000) {
+        game->playTurn();
+        mix(game->getState());
+    }
+    return h;
+}
+
+int main() {
+    // 1) The ring against two separate lists, under random draws, discards
+    //    and recycles with the same generator
+    int mismatches = 0;
+    long recycles = 0;
+    for (int round = 0; round < 500 && !mismatches; ++round) {
+        UNORng setup(29, round);
+        CardCode deck[kDeckSize];
+        for (int i = 0; i < kDeckSize; ++i) deck[i] = kCanonicalDeck.cards[i];
+        setup.shuffle(deck, kDeckSize);
+
+        CardPile pile;
+        pile.clear();
+        ListPiles ref;
+        for (int i = 0; i < kDeckSize; ++i) {
+            pile.pushDeck(deck[i]);
+            ref.deck.push_back(deck[i]);
+        }
+        UNORng rngA(round), rngB(round);
+        vector<CardCode> held;   // cards out of both piles, as if in hands
+        for (int step = 0; step < 3000 && !mismatches; ++step) {
+            uint32_t op = setup.bounded(3);
+            if (op == 0 || held.empty()) {
+                if (pile.getDeckSize() == 0) {
+                    bool a = pile.recycleDiscard(rngA);
+                    bool b = ref.recycle(rngB);
+                    if (a != b) ++mismatches;
+                    recycles += a;
+                }
+                CardCode a = pile.drawFront();
+                CardCode b = ref.draw();
+                if (a != b) ++mismatches;
+                if (a != kNoCard) held.push_back(a);
+            } else {
+                size_t i = setup.bounded(static_cast<uint32_t>(held.size()));
+                pile.pushDiscard(held[i]);
+                ref.discard.push_back(held[i]);
+                held.erase(held.begin() + i);
+            }
+            if (pile.top() != (ref.discard.empty() ? kNoCard : ref.discard.back()) ||
+                pile.getDeckSize() != static_cast<int>(ref.deck.size()) ||
+                pile.getDiscardSize() != static_cast<int>(ref.discard.size())) {
+                ++mismatches;
+            }
+        }
+    }
+    cout << "Ring vs separate piles: " << recycles << " recycles, "
+         << (mismatches ? "FAILED" : "ok") << endl;
+
+    // 2) No heap allocation while a game is played
+    long gamesChecked = 0, turnAllocations = 0, reshuffles = 0;
+    for (int g = 0; g < 2000; ++g) {
+        auto game = UNOGame::create(2 + g % 5, 4321, g);
+        game->initialize();
+        long before = allocations;
+        while (!game->isGameOver() && game->getStats().turns < 5000) game->playTurn();
+        turnAllocations += allocations - before;
+        reshuffles += game->getStats().reshuffles;
+        ++gamesChecked;
+    }
+    cout << "Allocations during play over " << gamesChecked << " games (" << reshuffles
+         << " reshuffles): " << turnAllocations << endl;
+
+    // 3) Fixed-seed transcripts stay exactly as recorded from this tree
+    uint64_t h = 0;
+    for (int g = 0; g < 50; ++g) h = h * 31 + transcriptHash(2029, g, 2 + g % 3);
+    const uint64_t kExpected = 0xb507743c381f6d98ULL;
+    cout << "Transcript hash: 0x" << hex << h << dec << (h == kExpected ? " ok" : " FAILED") << endl;
+
+    return !mismatches && turnAllocations == 0 && h == kExpected ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+#ifndef UNO_RNG_H
+#define UNO_RNG_H
+
+#include <cstdint>
+
+// ------------------------------
+// Counter-based random generator
+// ------------------------------
+// SplitMix-style: output i of a stream is mix64(start + i * gamma), so the
+// whole generator is two 64-bit words, jumping ahead any distance is one
+// multiply-add, and every stream (seed, stream id) gets its own odd gamma,
+// i.e. its own sequence rather than an offset into a shared one. Everything
+// is plain 64-bit integer arithmetic, so results are bit-identical on every
+// compiler and standard library - unlike std::shuffle over std::mt19937.
+class CounterRng {
+public:
+    typedef uint64_t result_type;
+
+    explicit CounterRng(uint64_t seed = 0, uint64_t stream = 0) {
+        reseed(seed, stream);
+    }
+
+    void reseed(uint64_t seed, uint64_t stream = 0) {
+        pos = mix64(seed + stream * kGolden);
+        gamma = mixGamma(seed ^ mix64(stream + kGolden));
+    }
+
+    // Next 64 random bits
+    uint64_t operator()() {
+        pos += gamma;
+        return mix64(pos);
+    }
+
+    // Skip the next n outputs in O(1)
+    void jump(uint64_t n) {
+        pos += n * gamma;
+    }
+
+    // Uniform integer in [0, range), range > 0 (Lemire's multiply-shift with
+    // exact rejection, so no modulo bias and no division on the fast path)
+    uint32_t bounded(uint32_t range) {
+        uint64_t m = static_cast<uint64_t>(next32()) * range;
+        uint32_t low = static_cast<uint32_t>(m);
+        if (low < range) {
+            uint32_t threshold = static_cast<uint32_t>(-range) % range;
+            while (low < threshold) {
+                m = static_cast<uint64_t>(next32()) * range;
+                low = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+
+    // Fisher-Yates over a[0..n)
+    template <class T>
+    void shuffle(T* a, int n) {
+        for (int i = n - 1; i > 0; --i) {
+            int j = static_cast<int>(bounded(static_cast<uint32_t>(i + 1)));
+            T t = a[i];
+            a[i] = a[j];
+            a[j] = t;
+        }
+    }
+
+    // The two state words, for serializing a generator mid-stream
+    uint64_t position() const { return pos; }
+    uint64_t increment() const { return gamma; }
+
+    // Restore saved words; rejected (generator unchanged) when the increment
+    // is even, which reseed() never produces
+    bool restore(uint64_t position, uint64_t increment) {
+        if ((increment & 1) == 0) return false;
+        pos = position;
+        gamma = increment;
+        return true;
+    }
+
+    bool operator==(const CounterRng& other) const {
+        return pos == other.pos && gamma == other.gamma;
+    }
+    bool operator!=(const CounterRng& other) const { return !(*this == other); }
+
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return ~static_cast<uint64_t>(0); }
+
+private:
+    static const uint64_t kGolden = 0x9E3779B97F4A7C15ULL;
+
+    uint64_t pos;
+    uint64_t gamma;  // always odd
+
+    uint32_t next32() { return static_cast<uint32_t>((*this)() >> 32); }
+
+    // splitmix64 finalizer
+    static uint64_t mix64(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Odd increment with enough bit transitions to step well (as in SplittableRandom)
+    static uint64_t mixGamma(uint64_t z) {
+        z = (z ^ (z >> 33)) * 0xFF51AFD7ED558CCDULL;
+        z = (z ^ (z >> 33)) * 0xC4CEB9FE1A85EC53ULL;
+        z = (z ^ (z >> 33)) | 1;
+        uint64_t flips = z ^ (z >> 1);
+        int n = 0;
+        for (; flips; flips &= flips - 1) ++n;
+        return n < 24 ? z ^ 0xAAAAAAAAAAAAAAAAULL : z;
+    }
+};
+
+#endif // UNO_RNG_H
@@ -0,0 +1,63 @@
+#include "uno_rng.h"
+#include "uno_cards.h"
+#include <iostream>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+using namespace std;
+
+int main() {
+    // Reference outputs: these must come out the same on every platform
+    const uint64_t expected[3] = { 0x99bf0867ced14dfULL, 0x9013aef974e2d52fULL, 0x6ba7f4f71a257ac1ULL };
+    CounterRng rng(1234);
+    bool referenceOk = true;
+    cout << hex;
+    for (int i = 0; i < 3; ++i) {
+        uint64_t v = rng();
+        cout << "rng(1234) #" << i << ": " << v << (v == expected[i] ? " ok" : " FAILED") << endl;
+        referenceOk = referenceOk && v == expected[i];
+    }
+    cout << dec;
+
+    // O(1) jump-ahead lands exactly where stepping does
+    CounterRng stepped(42, 7), jumped(42, 7);
+    for (int i = 0; i < 1000000; ++i) stepped();
+    jumped.jump(1000000);
+    bool jumpOk = stepped() == jumped();
+    cout << "Jump ahead matches stepping: " << (jumpOk ? "yes" : "no") << endl;
+
+    // Bounded draws are unbiased enough to see at a glance (each face within
+    // seven standard deviations of 100000)
+    CounterRng dice(5);
+    int faces[6] = {};
+    for (int i = 0; i < 600000; ++i) faces[dice.bounded(6)]++;
+    bool diceOk = true;
+    cout << "600000 d6 rolls:";
+    for (int f : faces) {
+        cout << " " << f;
+        diceOk = diceOk && f > 98000 && f < 102000;
+    }
+    cout << (diceOk ? "" : " FAILED") << endl;
+
+    // Shuffling the deck: our generator vs mt19937 + std::shuffle
+    const int rounds = 200000;
+    CardCode deck[kDeckSize];
+    memcpy(deck, kCanonicalDeck.cards, sizeof(deck));
+
+    auto t0 = chrono::steady_clock::now();
+    CounterRng ours(1);
+    for (int r = 0; r < rounds; ++r) ours.shuffle(deck, kDeckSize);
+    auto t1 = chrono::steady_clock::now();
+    mt19937 mt(1);
+    for (int r = 0; r < rounds; ++r) std::shuffle(deck, deck + kDeckSize, mt);
+    auto t2 = chrono::steady_clock::now();
+
+    double oursNs = chrono::duration<double, nano>(t1 - t0).count() / rounds;
+    double stdNs = chrono::duration<double, nano>(t2 - t1).count() / rounds;
+    cout << "Deck shuffle: CounterRng " << oursNs << " ns, mt19937 " << stdNs << " ns" << endl;
+    cout << "Generator size: " << sizeof(CounterRng) << " bytes (mt19937: " << sizeof(mt19937) << ")" << endl;
+    cout << "Top card after all shuffles: " << cardName(deck[0]) << endl;
+    return referenceOk && jumpOk && diceOk ? 0 : 1;
+}
@@ -0,0 +1,266 @@
+// uno_sim.cpp
+#include "uno_sim.h"
+#include "uno.h"
+#include "uno_batch.h"
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <memory>
+
+// ------------------------------
+// Work-stealing range queue
+// ------------------------------
+// Each worker owns a contiguous range of game indices packed into one
+// 64-bit word (lo in the low half, hi in the high half). The owner takes
+// small chunks from the front; an idle worker steals the back half of a
+// victim's range. Both sides only ever CAS the word, so no locks are taken.
+// Indices are handed out exactly once, so a stale (lo, hi) pair can never
+// reappear and the CAS is ABA-safe.
+namespace {
+
+const uint32_t kChunk = 64;
+
+inline uint64_t packRange(uint32_t lo, uint32_t hi) {
+    return (static_cast<uint64_t>(hi) << 32) | lo;
+}
+inline uint32_t rangeLo(uint64_t r) { return static_cast<uint32_t>(r); }
+inline uint32_t rangeHi(uint64_t r) { return static_cast<uint32_t>(r >> 32); }
+
+// Padded to a cache line so thieves hammering `bounds` don't slow down the
+// owner's writes to the results that follow it in WorkerSlot
+struct WorkRange {
+    std::atomic<uint64_t> bounds;
+    char pad[64 - sizeof(std::atomic<uint64_t>)];
+    WorkRange() : bounds(0) {}
+};
+
+// Owner side: claim up to kChunk indices from the front of our own range
+bool takeChunk(WorkRange& wr, uint32_t& lo, uint32_t& hi) {
+    uint64_t cur = wr.bounds.load(std::memory_order_acquire);
+    while (true) {
+        uint32_t l = rangeLo(cur), h = rangeHi(cur);
+        if (l >= h) return false;
+        uint32_t e = std::min(h, l + kChunk);
+        if (wr.bounds.compare_exchange_weak(cur, packRange(e, h), std::memory_order_acq_rel)) {
+            lo = l;
+            hi = e;
+            return true;
+        }
+    }
+}
+
+// Thief side: move the back half of victim's range into our (empty) range
+bool stealHalf(WorkRange& victim, WorkRange& self) {
+    uint64_t cur = victim.bounds.load(std::memory_order_acquire);
+    while (true) {
+        uint32_t l = rangeLo(cur), h = rangeHi(cur);
+        if (l >= h) return false;
+        uint32_t mid = l + (h - l) / 2;  // victim keeps [l, mid)
+        if (victim.bounds.compare_exchange_weak(cur, packRange(l, mid), std::memory_order_acq_rel)) {
+            self.bounds.store(packRange(mid, h), std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+UNOSimResults emptyResults(const UNOSimConfig& cfg) {
+    UNOSimResults r;
+    r.numPlayers = cfg.numPlayers;
+    r.bucketWidth = std::max(1, cfg.bucketWidth);
+    r.wins.assign(cfg.numPlayers, 0);
+    r.lengthHistogram.assign(cfg.maxTurns / r.bucketWidth + 1, 0);
+    return r;
+}
+
+// One heap-allocated slot per worker, so workers never write to each other's results
+struct WorkerSlot {
+    WorkRange range;
+    UNOSimResults local;
+};
+
+// Hands out one game index at a time from the worker's own chunk,
+// refilling from its range or by stealing when the chunk runs out
+class GameFeed {
+private:
+    std::vector<std::unique_ptr<WorkerSlot>>& slots;
+    size_t self;
+    uint32_t lo, hi;
+
+public:
+    GameFeed(std::vector<std::unique_ptr<WorkerSlot>>& s, size_t me)
+        : slots(s), self(me), lo(0), hi(0) {}
+
+    bool next(uint64_t& index) {
+        while (lo >= hi) {
+            if (takeChunk(slots[self]->range, lo, hi)) break;
+            // Out of local work: try every other worker once, starting next door
+            bool stole = false;
+            for (size_t k = 1; k < slots.size() && !stole; ++k) {
+                stole = stealHalf(slots[(self + k) % slots.size()]->range, slots[self]->range);
+            }
+            if (!stole) return false;
+        }
+        index = lo++;
+        return true;
+    }
+};
+
+void workerLoop(std::vector<std::unique_ptr<WorkerSlot>>& slots, size_t self, const UNOSimConfig& cfg) {
+    WorkerSlot& me = *slots[self];
+    GameFeed feed(slots, self);
+
+    if (cfg.lanes > 0) {
+        // Lane-batched engine: finished lanes pull their next game from the feed
+        std::unique_ptr<UNOBatch> batch(new UNOBatch(cfg.numPlayers, cfg.baseSeed, cfg.maxTurns, cfg.lanes));
+        batch->run([&feed](uint64_t& index) { return feed.next(index); }, me.local);
+        return;
+    }
+
+    uint64_t i;
+    while (feed.next(i)) {
+        auto game = UNOGame::create(cfg.numPlayers, cfg.baseSeed, i);
+        game->initialize();
+        while (!game->isGameOver() && game->getStats().turns < cfg.maxTurns) {
+            game->playTurn();
+        }
+        me.local.record(game->isGameOver(), game->getWinner(), game->getStats());
+    }
+}
+
+} // namespace
+
+// ------------------------------
+// UNOSimResults
+// ------------------------------
+UNOSimResults::UNOSimResults()
+    : numPlayers(0), gamesPlayed(0), unfinished(0), bucketWidth(1),
+      totalTurns(0), minTurns(0x7fffffff), maxTurns(0), cardsPlayed{0, 0, 0, 0},
+      totalReshuffles(0), maxReshuffles(0), threadsUsed(0), seconds(0.0) {}
+
+double UNOSimResults::winRate(int seat) const {
+    return gamesPlayed ? static_cast<double>(wins[seat]) / gamesPlayed : 0.0;
+}
+
+double UNOSimResults::meanTurns() const {
+    return gamesPlayed ? static_cast<double>(totalTurns) / gamesPlayed : 0.0;
+}
+
+int UNOSimResults::turnsPercentile(double p) const {
+    if (gamesPlayed == 0) return 0;
+    uint64_t target = static_cast<uint64_t>(p * gamesPlayed);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < lengthHistogram.size(); ++i) {
+        seen += lengthHistogram[i];
+        if (seen > target) return static_cast<int>((i + 1) * bucketWidth);
+    }
+    return maxTurns;
+}
+
+double UNOSimResults::gamesPerSecond() const {
+    return seconds > 0.0 ? gamesPlayed / seconds : 0.0;
+}
+
+void UNOSimResults::record(bool finished, int winner, const UNOGameStats& st) {
+    gamesPlayed++;
+    if (finished) wins[winner]++;
+    else unfinished++;
+
+    size_t bucket = std::min(static_cast<size_t>(st.turns / bucketWidth), lengthHistogram.size() - 1);
+    lengthHistogram[bucket]++;
+    totalTurns += st.turns;
+    minTurns = std::min(minTurns, st.turns);
+    maxTurns = std::max(maxTurns, st.turns);
+
+    for (int t = 0; t < 4; ++t) cardsPlayed[t] += st.cardsPlayed[t];
+    totalReshuffles += st.reshuffles;
+    maxReshuffles = std::max(maxReshuffles, st.reshuffles);
+}
+
+void UNOSimResults::merge(const UNOSimResults& other) {
+    gamesPlayed += other.gamesPlayed;
+    unfinished += other.unfinished;
+    for (size_t i = 0; i < wins.size(); ++i) wins[i] += other.wins[i];
+    for (size_t i = 0; i < lengthHistogram.size(); ++i) lengthHistogram[i] += other.lengthHistogram[i];
+    totalTurns += other.totalTurns;
+    minTurns = std::min(minTurns, other.minTurns);
+    maxTurns = std::max(maxTurns, other.maxTurns);
+    for (int t = 0; t < 4; ++t) cardsPlayed[t] += other.cardsPlayed[t];
+    totalReshuffles += other.totalReshuffles;
+    maxReshuffles = std::max(maxReshuffles, other.maxReshuffles);
+}
+
+std::string UNOSimResults::report() const {
+    static const char* typeNames[4] = { "Number", "Skip", "Reverse", "Draw Two" };
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(4);
+    ss << "Games: " << gamesPlayed << " (" << unfinished << " unfinished), "
+       << "Threads: " << threadsUsed << ", "
+       << std::setprecision(0) << gamesPerSecond() << " games/s\n";
+
+    ss << std::setprecision(4) << "Win rate by seat:";
+    for (int i = 0; i < numPlayers; ++i) ss << " P" << i << "=" << winRate(i);
+    ss << "\n";
+
+    ss << std::setprecision(2) << "Game length: mean " << meanTurns()
+       << ", min " << (gamesPlayed ? minTurns : 0) << ", max " << maxTurns
+       << ", p50 <=" << turnsPercentile(0.50)
+       << ", p90 <=" << turnsPercentile(0.90)
+       << ", p99 <=" << turnsPercentile(0.99) << "\n";
+
+    uint64_t totalPlayed = cardsPlayed[0] + cardsPlayed[1] + cardsPlayed[2] + cardsPlayed[3];
+    ss << "Cards played:";
+    for (int t = 0; t < 4; ++t) {
+        ss << " " << typeNames[t] << "=" << cardsPlayed[t]
+           << " (" << (totalPlayed ? 100.0 * cardsPlayed[t] / totalPlayed : 0.0) << "%)";
+    }
+    ss << "\n";
+
+    ss << "Reshuffles: total " << totalReshuffles << ", per game "
+       << (gamesPlayed ? static_cast<double>(totalReshuffles) / gamesPlayed : 0.0)
+       << ", max " << maxReshuffles;
+    return ss.str();
+}
+
+// ------------------------------
+// UNOSimulator
+// ------------------------------
+UNOSimResults UNOSimulator::run(const UNOSimConfig& requested) {
+    // Same seat rule as UNOGame::create, applied once so the results, every
+    // worker's counters and the games all agree on the seat count
+    UNOSimConfig cfg = requested;
+    cfg.numPlayers = std::min(std::max(cfg.numPlayers, 1), kMaxPlayers);
+    cfg.maxTurns = std::max(cfg.maxTurns, 0);
+
+    size_t threads = cfg.numThreads > 0 ? cfg.numThreads : std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    uint32_t total = static_cast<uint32_t>(std::min<uint64_t>(cfg.numGames, 0xffffffffULL));
+
+    // Split the index space evenly up front; stealing evens out the rest
+    std::vector<std::unique_ptr<WorkerSlot>> slots;
+    for (size_t t = 0; t < threads; ++t) {
+        slots.emplace_back(new WorkerSlot());
+        uint32_t lo = static_cast<uint32_t>(static_cast<uint64_t>(total) * t / threads);
+        uint32_t hi = static_cast<uint32_t>(static_cast<uint64_t>(total) * (t + 1) / threads);
+        slots[t]->range.bounds.store(packRange(lo, hi));
+        slots[t]->local = emptyResults(cfg);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads; ++t) {
+        pool.emplace_back(workerLoop, std::ref(slots), t, std::cref(cfg));
+    }
+    workerLoop(slots, 0, cfg);  // calling thread is worker 0
+    for (auto& th : pool) th.join();
+    auto end = std::chrono::steady_clock::now();
+
+    UNOSimResults results = emptyResults(cfg);
+    for (auto& slot : slots) results.merge(slot->local);
+    results.threadsUsed = static_cast<int>(threads);
+    results.seconds = std::chrono::duration<double>(end - start).count();
+    return results;
+}
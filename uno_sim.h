@@ -0,0 +1,71 @@
+#ifndef UNO_SIM_H
+#define UNO_SIM_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+struct UNOGameStats;
+
+// ------------------------------
+// Batch simulation settings
+// ------------------------------
+struct UNOSimConfig {
+    int numPlayers;       // clamped to 1..kMaxPlayers, like UNOGame::create
+    uint64_t numGames;    // at most 2^32 - 1
+    uint64_t baseSeed;    // game i plays on stream i of this seed
+    int numThreads;       // 0 = one per hardware thread
+    int maxTurns;         // games still running after this count as unfinished
+    int bucketWidth;      // game length histogram bucket size (turns)
+    int lanes;            // 0 = one game at a time, 1-64 = lane-batched engine (uno_batch.h)
+
+    UNOSimConfig()
+        : numPlayers(2), numGames(10000), baseSeed(1234),
+          numThreads(0), maxTurns(5000), bucketWidth(10), lanes(0) {}
+};
+
+// ------------------------------
+// Aggregated results of a batch
+// ------------------------------
+struct UNOSimResults {
+    int numPlayers;
+    uint64_t gamesPlayed;
+    uint64_t unfinished;                  // hit maxTurns without a winner
+    std::vector<uint64_t> wins;           // per seat
+    std::vector<uint64_t> lengthHistogram; // bucket i = turns in [i*w, (i+1)*w), last bucket open-ended
+    int bucketWidth;
+    uint64_t totalTurns;
+    int minTurns;
+    int maxTurns;
+    uint64_t cardsPlayed[4];              // indexed by Card::Type
+    uint64_t totalReshuffles;
+    int maxReshuffles;
+    int threadsUsed;
+    double seconds;
+
+    UNOSimResults();
+
+    double winRate(int seat) const;
+    double meanTurns() const;
+    int turnsPercentile(double p) const;  // upper edge of the bucket holding quantile p
+    double gamesPerSecond() const;
+
+    // Add one finished (or turn-capped) game
+    void record(bool finished, int winner, const UNOGameStats& stats);
+
+    // Fold another batch (same numPlayers / bucketWidth) into this one
+    void merge(const UNOSimResults& other);
+
+    std::string report() const;
+};
+
+// ------------------------------
+// Multi-threaded batch simulator
+// ------------------------------
+class UNOSimulator {
+public:
+    // Play cfg.numGames complete games on a work-stealing pool and aggregate
+    static UNOSimResults run(const UNOSimConfig& cfg);
+};
+
+#endif // UNO_SIM_H
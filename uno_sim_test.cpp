@@ -0,0 +1,33 @@
+#include "uno_sim.h"
+#include <iostream>
+
+using namespace std;
+
+int main() {
+    UNOSimConfig cfg;
+    cfg.numPlayers = 4;
+    cfg.numGames = 20000;
+    cfg.baseSeed = 1234;
+
+    UNOSimResults res = UNOSimulator::run(cfg);
+    cout << res.report() << endl;
+
+    // Same base seed must give the same aggregate, whatever the thread count
+    cfg.numThreads = 3;
+    UNOSimResults again = UNOSimulator::run(cfg);
+    bool same = again.wins == res.wins && again.totalTurns == res.totalTurns &&
+                again.totalReshuffles == res.totalReshuffles;
+    cout << "Reproducible across thread counts: " << (same ? "yes" : "no") << endl;
+
+    // Out-of-range seat counts are clamped like UNOGame::create does
+    cfg.numGames = 200;
+    cfg.numPlayers = 0;
+    UNOSimResults none = UNOSimulator::run(cfg);
+    cfg.numPlayers = 12;
+    UNOSimResults many = UNOSimulator::run(cfg);
+    bool clamped = none.numPlayers == 1 && none.wins.size() == 1 && none.gamesPlayed == 200 &&
+                   many.numPlayers == 10 && many.wins.size() == 10 && many.gamesPlayed == 200;
+    cout << "Seat counts 0 and 12 clamped to 1 and 10: " << (clamped ? "yes" : "no") << endl;
+
+    return same && clamped ? 0 : 1;
+}
@@ -0,0 +1,419 @@
+// uno_solver.cpp
+#include "uno_solver.h"
+#include "uno_cards.h"
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const int8_t kSolvedDepth = 127;
+const int kRunning = 2;
+
+double nowSeconds() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+// ------------------------------
+// Multiset of cards
+// ------------------------------
+// A deck holds at most two copies of any card, so a multiset is two card
+// sets: `one` has the cards held at least once, `two` those held twice.
+struct CardSet {
+    uint64_t one, two;
+
+    int count(CardCode c) const {
+        return static_cast<int>((one >> c) & 1) + static_cast<int>((two >> c) & 1);
+    }
+    int size() const { return __builtin_popcountll(one) + __builtin_popcountll(two); }
+    bool empty() const { return one == 0; }
+
+    void add(CardCode c) {
+        uint64_t bit = 1ULL << c;
+        if (one & bit) two |= bit;
+        else one |= bit;
+    }
+    void remove(CardCode c) {
+        uint64_t bit = 1ULL << c;
+        if (two & bit) two &= ~bit;
+        else one &= ~bit;
+    }
+};
+
+// ------------------------------
+// Zobrist keys
+// ------------------------------
+// One key per (place, card, copy), where the places are the two hands, the
+// deck and the discards under the top card, plus keys for the top card, the
+// side to move and pending Draw Two cards
+enum Place { HAND0, HAND1, DECK, DISCARD, kPlaces };
+
+struct ZobristKeys {
+    uint64_t card[kPlaces][kCardCodeSpace][2];
+    uint64_t top[kCardCodeSpace + 1];   // last slot: no top card
+    uint64_t side[2];
+    uint64_t pending[3];
+
+    ZobristKeys() {
+        CounterRng rng(0x5EED0F2B, 34);
+        for (int p = 0; p < kPlaces; ++p)
+            for (int c = 0; c < kCardCodeSpace; ++c)
+                for (int k = 0; k < 2; ++k) card[p][c][k] = rng();
+        for (int c = 0; c <= kCardCodeSpace; ++c) top[c] = rng();
+        for (int s = 0; s < 2; ++s) side[s] = rng();
+        for (int d = 0; d < 3; ++d) pending[d] = rng();
+    }
+};
+
+const ZobristKeys& zobrist() {
+    static const ZobristKeys keys;
+    return keys;
+}
+
+inline int topSlot(CardCode c) { return c == kNoCard ? kCardCodeSpace : c; }
+
+// Cards tried first: those that keep the turn, then Draw Twos, then numbers
+inline int playOrder(CardCode c) {
+    int kind = codeKind(c);
+    if (kind == kKindSkip || kind == kKindReverse) return 0;
+    if (kind == kKindDrawTwo) return 1;
+    return 2;
+}
+
+} // namespace
+
+// ------------------------------
+// Search position
+// ------------------------------
+// Everything the solver needs and nothing it doesn't: card order in the
+// hands and the deck is irrelevant once hands are known and draws are
+// chance nodes, so all four card places are multisets
+struct UNOSolver::Node {
+    CardSet place[kPlaces];
+    CardCode top;
+    uint8_t toMove;
+    uint8_t pending;    // cards the other player still has to draw for a Draw Two
+    uint8_t winner;     // seat, or kRunning
+    uint64_t hash;
+
+    void add(int p, CardCode c) {
+        hash ^= zobrist().card[p][c][place[p].count(c)];
+        place[p].add(c);
+    }
+    void remove(int p, CardCode c) {
+        place[p].remove(c);
+        hash ^= zobrist().card[p][c][place[p].count(c)];
+    }
+    void setTop(CardCode c) {
+        hash ^= zobrist().top[topSlot(top)] ^ zobrist().top[topSlot(c)];
+        top = c;
+    }
+    void setToMove(int p) {
+        hash ^= zobrist().side[toMove] ^ zobrist().side[p];
+        toMove = static_cast<uint8_t>(p);
+    }
+    void setPending(int d) {
+        hash ^= zobrist().pending[pending] ^ zobrist().pending[d];
+        pending = static_cast<uint8_t>(d);
+    }
+
+    uint64_t playable(int p) const { return place[p].one & kMatchTable.mask[top]; }
+
+    // Deck empty: the discards under the top card become the deck
+    void recycle() {
+        for (uint64_t b = place[DISCARD].one | place[DISCARD].two; b; b &= b - 1) {
+            CardCode c = static_cast<CardCode>(__builtin_ctzll(b));
+            for (int k = place[DISCARD].count(c); k > 0; --k) {
+                remove(DISCARD, c);
+                add(DECK, c);
+            }
+        }
+    }
+
+    // Put `c` on the discard pile and apply its effect, as makeMove does
+    void play(CardCode c, bool fromHand) {
+        int p = toMove;
+        if (fromHand) remove(p, c);
+        if (top != kNoCard) add(DISCARD, top);
+        setTop(c);
+        if (fromHand && place[p].empty()) {
+            winner = static_cast<uint8_t>(p);
+            return;
+        }
+        int kind = codeKind(c);
+        if (kind == kKindDrawTwo) setPending(2);   // other player draws, then it's p again
+        else if (kind <= 9) setToMove(1 - p);      // Skip and Reverse keep the turn with two players
+    }
+
+    // Scored from the hand sizes when the depth limit cuts a line off;
+    // `extra` unnamed cards are counted into `seat`'s hand
+    double estimate(int seat = 0, int extra = 0) const {
+        // Pending Draw Two cards are already as good as in the other hand
+        double diff = place[HAND1].size() - place[HAND0].size();
+        diff += seat == 0 ? -extra : extra;
+        diff += toMove == 0 ? pending + 0.5 : -pending - 0.5;
+        return 1.0 / (1.0 + std::exp(-0.6 * diff));
+    }
+};
+
+UNOSolver::UNOSolver(int tableBits)
+    : table(size_t(1) << std::min(std::max(tableBits, 10), 28)),
+      mask(table.size() - 1),
+      nodes(0), cutoffs(0), deadline(0), aborted(false), rootBest(kNoCard)
+{
+    clear();
+}
+
+void UNOSolver::clear() {
+    Entry empty;
+    empty.key = 0;
+    empty.lower = 0.0f;
+    empty.upper = 1.0f;
+    empty.depth = -1;
+    empty.best = kNoCard;
+    std::fill(table.begin(), table.end(), empty);
+}
+
+bool UNOSolver::outOfTime() {
+    if (!aborted && (nodes & 1023) == 0 && nowSeconds() > deadline) aborted = true;
+    return aborted;
+}
+
+UNOSolverResult UNOSolver::solve(const UNOState& s, double seconds, int maxDepth) {
+    UNOSolverResult res;
+    double start = nowSeconds();
+
+    if (s.gameOver || s.numPlayers != 2) {
+        if (!s.gameOver) res.bestMove = greedyMove(s);
+        res.value = s.gameOver ? (s.winner == s.currentPlayer ? 1.0 : 0.0) : 0.5;
+        res.exact = s.gameOver;
+        return res;
+    }
+
+    // Build the root: both hands, the deck run and the discards under the top card
+    const ZobristKeys& z = zobrist();
+    Node root;
+    for (int p = 0; p < kPlaces; ++p) root.place[p].one = root.place[p].two = 0;
+    root.top = s.pile.top();
+    root.toMove = s.currentPlayer;
+    root.pending = 0;
+    root.winner = kRunning;
+    root.hash = z.top[topSlot(root.top)] ^ z.side[root.toMove] ^ z.pending[0];
+    for (int p = 0; p < 2; ++p) {
+        const CardHand& hand = s.hands[p];
+        for (uint64_t b = hand.present; b; b &= b - 1) {
+            CardCode c = static_cast<CardCode>(__builtin_ctzll(b));
+            for (int k = hand.copies(c); k > 0; --k) root.add(p, c);
+        }
+    }
+    for (int i = 0; i < s.pile.deckCount; ++i) root.add(DECK, s.pile.cards[s.pile.at(i)]);
+    for (int i = 0; i + 1 < s.pile.discardCount; ++i) {
+        root.add(DISCARD, s.pile.cards[s.pile.at(s.pile.deckCount + i)]);
+    }
+
+    nodes = 0;
+    aborted = false;
+    deadline = start + seconds;
+    res.bestMove = greedyMove(s);
+
+    // Table entries keep their depth in an int8_t and kSolvedDepth marks
+    // exact ones, so deeper limits would wrap or pass for solved
+    maxDepth = std::min(maxDepth, kSolvedDepth - 1);
+
+    // Iterative deepening: each finished iteration replaces the answer
+    for (int depth = 1; depth <= maxDepth; ++depth) {
+        cutoffs = 0;
+        rootBest = kNoCard;
+        double v = search(root, depth, 0, 0.0, 1.0);
+        if (aborted) break;
+
+        res.value = root.toMove == 0 ? v : 1.0 - v;
+        res.bestMove = rootBest == kNoCard ? UNOMove::draw() : UNOMove::play(rootBest);
+        res.depth = depth;
+        if (cutoffs == 0) {
+            res.exact = true;
+            break;
+        }
+    }
+
+    res.nodes = nodes;
+    res.seconds = nowSeconds() - start;
+    return res;
+}
+
+// Value is P(seat 0 wins); seat 0 maximises, seat 1 minimises. Fail-soft:
+// a result <= alpha is an upper bound, >= beta a lower bound.
+double UNOSolver::search(const Node& n, int depth, int ply, double alpha, double beta) {
+    ++nodes;
+    if (n.winner != kRunning) return n.winner == 0 ? 1.0 : 0.0;
+    if (outOfTime()) return 0.0;
+
+    // Transposition table
+    Entry& e = table[n.hash & mask];
+    CardCode hashBest = kNoCard;
+    if (e.key == n.hash) {
+        hashBest = e.best;
+        if (e.depth >= depth && ply > 0) {
+            bool cut = e.lower >= beta || e.upper <= alpha || e.lower == e.upper;
+            if (cut) {
+                if (e.depth != kSolvedDepth) ++cutoffs;
+                return e.lower >= beta ? e.lower : e.upper;
+            }
+        }
+    }
+
+    uint64_t cutoffsBefore = cutoffs;
+    double value;
+    CardCode best = kNoCard;
+
+    if (depth == 0) {
+        ++cutoffs;
+        return n.estimate();
+    } else if (n.pending > 0) {
+        // The other player draws for a Draw Two
+        value = drawChance(n, depth, ply, alpha, beta);
+    } else if (uint64_t playable = n.playable(n.toMove)) {
+        // Choose a card: try the table's move, then the turn-keeping cards
+        CardCode moves[kHandSlots];
+        int count = 0;
+        for (uint64_t b = playable; b; b &= b - 1) moves[count++] = static_cast<CardCode>(__builtin_ctzll(b));
+        std::stable_sort(moves, moves + count, [hashBest](CardCode a, CardCode b) {
+            int ka = a == hashBest ? -1 : playOrder(a);
+            int kb = b == hashBest ? -1 : playOrder(b);
+            return ka < kb;
+        });
+
+        bool maximise = n.toMove == 0;
+        double a = alpha, b = beta;
+        value = maximise ? -1.0 : 2.0;
+        for (int i = 0; i < count; ++i) {
+            Node child = n;
+            child.play(moves[i], true);
+            double v = search(child, depth - 1, ply + 1, a, b);
+            if (aborted) return 0.0;
+            if (maximise ? v > value : v < value) {
+                value = v;
+                best = moves[i];
+            }
+            if (maximise) a = std::max(a, v);
+            else b = std::min(b, v);
+            if (a >= b) break;
+        }
+        if (ply == 0) rootBest = best;
+    } else {
+        // Nothing to play: draw
+        value = drawChance(n, depth, ply, alpha, beta);
+    }
+    if (aborted) return 0.0;
+
+    // Store, replacing shallower or unrelated entries
+    int8_t storeDepth = cutoffs == cutoffsBefore ? kSolvedDepth : static_cast<int8_t>(depth);
+    if (e.key != n.hash || storeDepth >= e.depth) {
+        e.key = n.hash;
+        e.depth = storeDepth;
+        e.lower = value > alpha ? static_cast<float>(value) : 0.0f;
+        e.upper = value < beta ? static_cast<float>(value) : 1.0f;
+        e.best = best;
+    }
+    return value;
+}
+
+// Chance node over the next card off the deck. With n.pending set the other
+// player takes it for a Draw Two; otherwise the player to move draws for
+// their turn, playing the card at once if it matches.
+//
+// Star1 pruning: with the value of the children seen so far and the [0, 1]
+// range of the rest, each child gets the narrowest window that can still
+// change the result, and the node stops as soon as it can't leave (alpha, beta).
+double UNOSolver::drawChance(const Node& n, int depth, int ply, double alpha, double beta) {
+    Node base = n;
+    if (base.place[DECK].empty()) base.recycle();
+    bool penalty = base.pending > 0;
+    int drawer = penalty ? 1 - base.toMove : base.toMove;
+
+    if (base.place[DECK].empty()) {
+        // Nothing left anywhere
+        if (penalty) {
+            base.setPending(0);
+            return search(base, depth, ply + 1, alpha, beta);
+        }
+        // A pass. If the other player can't play either, nobody ever will.
+        if (!base.playable(1 - drawer)) return 0.5;
+        base.setToMove(1 - drawer);
+        return search(base, depth - 1, ply + 1, alpha, beta);
+    }
+
+    double total = base.place[DECK].size();
+    if (penalty && depth == 1) {
+        // Last ply: whichever card it is, the victim's hand grows by one
+        ++cutoffs;
+        return base.estimate();
+    }
+    if (depth == 1) {
+        // Last ply: every card that doesn't match is kept and leaves the same
+        // hand sizes, so score the draw in one pass instead of a node per card
+        ++cutoffs;
+        Node keep = base;
+        keep.toMove = static_cast<uint8_t>(1 - drawer);
+        double keepValue = keep.estimate(drawer, 1);
+        double sum = 0.0;
+        for (uint64_t cards = base.place[DECK].one; cards; cards &= cards - 1) {
+            CardCode c = static_cast<CardCode>(__builtin_ctzll(cards));
+            double p = base.place[DECK].count(c) / total;
+            if (codesMatch(base.top, c)) {
+                Node child = base;
+                child.remove(DECK, c);
+                child.play(c, false);
+                sum += p * child.estimate();
+            } else {
+                sum += p * keepValue;
+            }
+        }
+        return sum;
+    }
+
+    double sum = 0.0;        // probability-weighted value of the children so far
+    double remaining = 1.0;  // probability mass still to search
+    uint64_t cards = base.place[DECK].one;
+    for (; cards; cards &= cards - 1) {
+        CardCode c = static_cast<CardCode>(__builtin_ctzll(cards));
+        double p = base.place[DECK].count(c) / total;
+        remaining -= p;
+
+        Node child = base;
+        child.remove(DECK, c);
+        if (penalty) {
+            child.add(drawer, c);
+            child.setPending(child.pending - 1);
+        } else {
+            if (codesMatch(child.top, c)) {
+                child.play(c, false);
+            } else {
+                child.add(drawer, c);
+                child.setToMove(1 - drawer);
+            }
+        }
+
+        double lo = std::max(0.0, (alpha - sum - remaining) / p);
+        double hi = std::min(1.0, (beta - sum) / p);
+        double v = search(child, depth - 1, ply + 1, lo, hi);
+        if (aborted) return 0.0;
+        sum += p * v;
+        if (sum + remaining <= alpha) return sum + remaining;
+        if (sum >= beta) return sum;
+    }
+    return sum;
+}
+
+std::string UNOSolverResult::report() const {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(4);
+    ss << "Best move: " << (bestMove.kind == UNOMove::DRAW ? std::string("Draw") : cardName(bestMove.card))
+       << ", win probability " << value << (exact ? " (exact)" : "") << "\n";
+    ss << std::setprecision(2) << "Depth " << depth << ", " << nodes << " nodes in " << seconds << " s, "
+       << std::setprecision(0) << nodesPerSecond() << " nodes/s";
+    return ss.str();
+}
@@ -0,0 +1,80 @@
+#ifndef UNO_SOLVER_H
+#define UNO_SOLVER_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "uno_state.h"
+
+// ------------------------------
+// Result of one solve
+// ------------------------------
+struct UNOSolverResult {
+    UNOMove bestMove;
+    double value;       // probability the player to move wins with best play by both sides
+    bool exact;         // every line reached the end of the game (no depth cut-off)
+    int depth;          // deepest iteration that finished inside the time budget
+    uint64_t nodes;
+    double seconds;
+
+    UNOSolverResult()
+        : bestMove(UNOMove::draw()), value(0.5), exact(false), depth(0), nodes(0), seconds(0) {}
+
+    double nodesPerSecond() const { return seconds > 0 ? nodes / seconds : 0; }
+    std::string report() const;
+};
+
+// ------------------------------
+// Perfect-information endgame solver
+// ------------------------------
+// Two-player positions with both hands known. Only the deck order stays
+// hidden, so every draw is a chance node over the cards left in the deck
+// (or, once it runs dry, over the reshuffled discards). The search is
+// expectimax with alpha-beta at the play choices and Star1 bounds at the
+// chance nodes, on win probabilities in [0, 1].
+//
+// Positions are Zobrist-hashed into a fixed-size transposition table that
+// keeps its entries between solves. Iterative deepening stops when the
+// time budget runs out (the last finished depth is reported) or when an
+// iteration resolves every line to the end of the game, which makes the
+// value exact. Depth counts plies: each card played and each card drawn
+// (both cards of a Draw Two penalty included). Lines cut off at the depth
+// limit are scored from the hand sizes. maxDepth is capped at 126.
+//
+// Positions with another player count return the greedy move at depth 0.
+class UNOSolver {
+public:
+    // Transposition table of 2^tableBits entries (24 bytes each)
+    explicit UNOSolver(int tableBits = 20);
+
+    UNOSolverResult solve(const UNOState& s, double seconds, int maxDepth = 100);
+
+    // Forget everything in the transposition table
+    void clear();
+
+private:
+    struct Node;
+    struct Entry {
+        uint64_t key;
+        float lower, upper;     // bounds on P(seat 0 wins)
+        int8_t depth;           // kSolvedDepth when no line was cut off
+        CardCode best;
+        uint8_t pad[2];
+    };
+
+    std::vector<Entry> table;
+    uint64_t mask;
+
+    // Per-solve search state
+    uint64_t nodes;
+    uint64_t cutoffs;           // depth-limit evaluations (and uses of entries that relied on them)
+    double deadline;
+    bool aborted;
+    CardCode rootBest;
+
+    double search(const Node& n, int depth, int ply, double alpha, double beta);
+    double drawChance(const Node& n, int depth, int ply, double alpha, double beta);
+    bool outOfTime();
+};
+
+#endif // UNO_SOLVER_H
@@ -0,0 +1,72 @@
+#include "uno.h"
+#include "uno_solver.h"
+#include <iostream>
+
+using namespace std;
+
+// Play greedy turns from a fresh two-player deal until both hands hold at
+// most `cards` (or at least `cards` when grow is set)
+static bool reach(UNOState& s, uint64_t seed, int cards, bool grow) {
+    s.rng.reseed(seed);
+    s.numPlayers = 2;
+    dealState(s);
+    while (!s.gameOver) {
+        int a = s.hands[0].getSize(), b = s.hands[1].getSize();
+        if (grow ? (a >= cards && b >= cards) : (a <= cards && b <= cards)) return true;
+        UNOUndo undo;
+        makeMove(s, greedyMove(s), undo);
+    }
+    return false;
+}
+
+int main() {
+    UNOSolver solver;
+
+    // Hand-built position with a known answer. P0 holds Blue 7 on Red 5 and
+    // must draw: Red 7 is played at once, P1 (Yellow 5) can't follow and
+    // P0 then wins with Blue 7; Green 2 is kept and P1 wins with Yellow 5.
+    UNOState known;
+    known.rng.reseed(1);
+    known.numPlayers = 2;
+    known.currentPlayer = 0;
+    known.clockwise = true;
+    known.gameOver = false;
+    known.winner = -1;
+    known.hands[0].clear();
+    known.hands[1].clear();
+    known.pile.clear();
+    known.hands[0].pushBack(cardCode(Card::BLUE, 7));
+    known.hands[1].pushBack(cardCode(Card::YELLOW, 5));
+    known.pile.pushDeck(cardCode(Card::RED, 7));
+    known.pile.pushDeck(cardCode(Card::GREEN, 2));
+    known.pile.pushDiscard(cardCode(Card::RED, 5));
+    UNOSolverResult res = solver.solve(known, 1.0);
+    cout << formatState(known) << endl << res.report() << endl;
+    bool knownOk = res.exact && res.value == 0.5;
+    cout << "Known position: " << (knownOk ? "ok" : "FAILED") << endl;
+
+    // Depth limits past the table's int8_t depths are capped, not wrapped
+    bool capOk = true;
+    for (int limit : { 126, 127, 1000 }) {
+        solver.clear();
+        UNOSolverResult r = solver.solve(known, 1.0, limit);
+        capOk = capOk && r.exact && r.value == 0.5 && r.depth == res.depth;
+    }
+    cout << "maxDepth 126 / 127 / 1000 agree: " << (capOk ? "ok" : "FAILED") << endl << endl;
+
+    // A late endgame
+    UNOState end;
+    uint64_t seed = 1;
+    while (!reach(end, seed, 2, false)) ++seed;
+    solver.clear();
+    cout << formatState(end) << endl << solver.solve(end, 1.0).report() << endl << endl;
+
+    // A middle game with ten cards a hand
+    UNOState mid;
+    seed = 1;
+    while (!reach(mid, seed, 10, true)) ++seed;
+    solver.clear();
+    cout << formatState(mid) << endl << solver.solve(mid, 3.0).report() << endl;
+
+    return knownOk && capOk ? 0 : 1;
+}
@@ -0,0 +1,306 @@
+#ifndef UNO_STATE_H
+#define UNO_STATE_H
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include "uno_cards.h"
+#include "uno_rng.h"
+
+struct UNOGameStats;
+
+// Random engine carried inside the game state (drives every shuffle)
+typedef CounterRng UNORng;
+
+const int kMaxPlayers = 10;
+const int kHandSlots = kCardColors * kCardKinds;  // 52 distinct cards
+const int kMaxMoves = 16;                         // 13 same-colour + 3 same-kind plays
+
+// Dense 0-51 index of a card code, used for per-card arrays
+inline int handSlot(CardCode c) { return codeColor(c) * kCardKinds + codeKind(c); }
+
+// ------------------------
+// Count-matrix hand
+// ------------------------
+// A hand is the 64-bit set of card codes it holds plus, for each of the 52
+// cards, the order in which its (at most two) copies were added. "Which
+// cards can I play" is then one AND with the top card's match mask, and the
+// order stamps resolve "first encountered" ties exactly like a linked-list
+// scan would. Stamps are bytes; when they run out the hand is renumbered
+// 0..size-1, which keeps their relative order.
+struct CardHand {
+    static const uint8_t kEmpty = 0xFF;
+
+    uint64_t present;                 // bit c set when the hand holds card code c
+    uint8_t order[kHandSlots][2];     // insertion stamps, oldest first, kEmpty if absent
+    uint8_t size;
+    uint8_t nextOrder;
+
+    void clear() {
+        present = 0;
+        std::memset(order, kEmpty, sizeof(order));
+        size = 0;
+        nextOrder = 0;
+    }
+
+    bool isEmpty() const { return size == 0; }
+    int getSize() const { return size; }
+
+    int copies(CardCode c) const {
+        const uint8_t* o = order[handSlot(c)];
+        return (o[0] != kEmpty) + (o[1] != kEmpty);
+    }
+
+    void pushBack(CardCode c) {
+        if (!isCardCode(c)) return;
+        uint8_t* o = order[handSlot(c)];
+        if (o[1] != kEmpty) return;  // no card appears more than twice in the deck
+        if (nextOrder == kEmpty) renumber();
+        o[o[0] == kEmpty ? 0 : 1] = nextOrder++;
+        present |= 1ULL << c;
+        ++size;
+    }
+
+    // remove the oldest copy of the supplied card; returns its stamp (kEmpty if absent)
+    uint8_t removeCard(CardCode c) {
+        if (!isCardCode(c)) return kEmpty;
+        uint8_t* o = order[handSlot(c)];
+        uint8_t stamp = o[0];
+        if (stamp == kEmpty) return kEmpty;
+        o[0] = o[1];
+        o[1] = kEmpty;
+        if (o[0] == kEmpty) present &= ~(1ULL << c);
+        --size;
+        return stamp;
+    }
+
+    // Exact inverses of removeCard / pushBack, for unmakeMove
+    void restoreOldest(CardCode c, uint8_t stamp) {
+        uint8_t* o = order[handSlot(c)];
+        o[1] = o[0];
+        o[0] = stamp;
+        present |= 1ULL << c;
+        ++size;
+    }
+    void popNewest(CardCode c) {
+        uint8_t* o = order[handSlot(c)];
+        if (o[1] != kEmpty) o[1] = kEmpty;
+        else {
+            o[0] = kEmpty;
+            present &= ~(1ULL << c);
+        }
+        --size;
+        --nextOrder;
+    }
+
+    // Cards that may be played on `top`
+    uint64_t playable(CardCode top) const {
+        return present & kMatchTable.mask[top];
+    }
+
+    // find playable card according to the priority rules:
+    // 1) color match (first encountered)
+    // 2) value match (number) (first encountered)
+    // 3) action cards in order Skip -> Reverse -> Draw Two (first encountered)
+    // Off-colour cards only match on kind, so steps 2 and 3 both reduce to
+    // "oldest card of the top card's kind".
+    bool findPlayable(CardCode top, CardCode& chosen) const {
+        uint64_t p = playable(top);
+        if (!p) return false;
+
+        uint64_t sameColor = p & colorBits(codeColor(top));
+        uint64_t candidates = sameColor ? sameColor : p;
+
+        int best = __builtin_ctzll(candidates);
+        candidates &= candidates - 1;
+        while (candidates) {
+            int c = __builtin_ctzll(candidates);
+            candidates &= candidates - 1;
+            if (order[handSlot(c)][0] < order[handSlot(best)][0]) best = c;
+        }
+        chosen = static_cast<CardCode>(best);
+        return true;
+    }
+
+    // Compact the stamps to 0..size-1, keeping their relative order
+    void renumber() {
+        uint8_t rank[256] = {};
+        for (int s = 0; s < kHandSlots; ++s) {
+            if (order[s][0] != kEmpty) rank[order[s][0]] = 1;
+            if (order[s][1] != kEmpty) rank[order[s][1]] = 1;
+        }
+        uint8_t next = 0;
+        for (int v = 0; v < kEmpty; ++v) {
+            if (rank[v]) rank[v] = next++;
+        }
+        for (int s = 0; s < kHandSlots; ++s) {
+            if (order[s][0] != kEmpty) order[s][0] = rank[order[s][0]];
+            if (order[s][1] != kEmpty) order[s][1] = rank[order[s][1]];
+        }
+        nextOrder = next;
+    }
+};
+
+// ------------------------
+// Deck + discard ring
+// ------------------------
+// Cards are never created or destroyed during a game, so the draw pile and
+// the discard pile together never hold more than the full deck. Both live in
+// one fixed ring: the deck is the run starting at `head`, the discard pile
+// follows straight after it, and the last discard is the top card. Drawing
+// advances `head`; discarding writes just past the top. When the deck runs
+// dry the discard run (minus its top) simply becomes the deck again and is
+// shuffled where it lies - nothing is copied or allocated.
+struct CardPile {
+    CardCode cards[kDeckSize];
+    uint8_t head;          // ring index of the next card to draw
+    uint8_t deckCount;
+    uint8_t discardCount;
+
+    int at(int offset) const { return (head + offset) % kDeckSize; }
+
+    void clear() {
+        head = 0;
+        deckCount = 0;
+        discardCount = 0;
+    }
+
+    int getDeckSize() const { return deckCount; }
+    int getDiscardSize() const { return discardCount; }
+
+    // Append to the bottom of the deck (only valid while the discard pile is empty)
+    void pushDeck(CardCode c) {
+        cards[at(deckCount++)] = c;
+    }
+
+    CardCode drawFront() {
+        if (deckCount == 0) return kNoCard;
+        CardCode c = cards[head];
+        head = static_cast<uint8_t>(at(1));
+        --deckCount;
+        return c;
+    }
+
+    void pushDiscard(CardCode c) {
+        cards[at(deckCount + discardCount++)] = c;
+    }
+
+    CardCode top() const {
+        return discardCount ? cards[at(deckCount + discardCount - 1)] : kNoCard;
+    }
+
+    // Turn all discards except the top into a freshly shuffled deck.
+    // Only called with an empty deck, so the discard run starts at `head`.
+    bool recycleDiscard(UNORng& rng) {
+        if (deckCount != 0 || discardCount < 2) return false;
+        // Rotate the ring so the run is contiguous; in place, no allocation
+        std::rotate(cards, cards + head, cards + kDeckSize);
+        head = 0;
+        deckCount = static_cast<uint8_t>(discardCount - 1);
+        discardCount = 1;
+        rng.shuffle(cards, deckCount);
+        return true;
+    }
+};
+
+// ------------------------------
+// Flat game state
+// ------------------------------
+// Everything a position needs, with no pointers: copying a game for search
+// is a memcpy of copyBytes() (hands past numPlayers are never touched).
+struct UNOState {
+    UNORng rng;
+    uint8_t numPlayers;
+    uint8_t currentPlayer;
+    bool clockwise;
+    bool gameOver;
+    int8_t winner;          // -1 while the game is running
+    CardPile pile;
+    CardHand hands[kMaxPlayers];
+
+    size_t copyBytes() const {
+        return offsetof(UNOState, hands) + numPlayers * sizeof(CardHand);
+    }
+
+    void copyFrom(const UNOState& other) {
+        std::memcpy(this, &other, other.copyBytes());
+    }
+};
+
+// ------------------------------
+// Moves
+// ------------------------------
+// PLAY puts `card` from the current hand on the discard pile. DRAW is only
+// legal when nothing is playable; a drawn card that matches is played at once.
+struct UNOMove {
+    enum Kind : uint8_t { PLAY, DRAW };
+
+    uint8_t kind;
+    CardCode card;   // PLAY only
+
+    static UNOMove play(CardCode c) { UNOMove m; m.kind = PLAY; m.card = c; return m; }
+    static UNOMove draw() { UNOMove m; m.kind = DRAW; m.card = kNoCard; return m; }
+};
+
+// Everything makeMove changed, so unmakeMove can put it back. The pile and
+// hand snapshots are only filled in on the rare moves that need them.
+struct UNOUndo {
+    UNORng rng;
+    uint8_t currentPlayer;
+    bool clockwise;
+    bool gameOver;
+    int8_t winner;
+    uint8_t pileHead, deckCount, discardCount;
+
+    CardCode removed;            // card taken out of the mover's hand (kNoCard if none)
+    uint8_t removedStamp;
+    uint8_t mover;
+    CardCode drawn;              // DRAW only: the card the mover drew (kNoCard if none)
+    bool drawnPlayed;            // ... and whether it matched and was played
+
+    uint8_t numPushed;           // cards added to hands, in order
+    uint8_t pushedTo[2];
+    CardCode pushedCard[2];
+
+    bool reshuffled;             // pileCards holds the ring before the first reshuffle
+    int8_t renumberedAt;         // push index whose hand renumbered its stamps, or -1
+    CardCode pileCards[kDeckSize];
+    CardHand renumberedHand;     // that hand as it was before the push
+};
+
+// Deal a fresh game into `s` using s.rng (numPlayers must already be set)
+void dealState(UNOState& s);
+
+// Legal moves for the current player; returns how many were written to out
+int legalMoves(const UNOState& s, UNOMove out[kMaxMoves]);
+
+// True when `m` is one of legalMoves(s)
+bool isLegalMove(const UNOState& s, const UNOMove& m);
+
+// The built-in greedy policy (the card findPlayable picks, else DRAW)
+UNOMove greedyMove(const UNOState& s);
+
+// Apply a legal move; stats (optional) are updated like playTurn() does
+void makeMove(UNOState& s, const UNOMove& m, UNOUndo& undo, UNOGameStats* stats = nullptr);
+void unmakeMove(UNOState& s, const UNOUndo& undo);
+
+// Resample everything `observer` can't see - the other hands and the deck
+// order - keeping every hand size and the discard pile as they are
+void determinize(UNOState& s, int observer, UNORng& rng);
+
+// What the player to move may look at, for handing to a strategy: `s` with
+// the other hands and the deck order resampled by determinize() and the
+// game's generator replaced by one drawn from `rng`, so neither the real
+// cards nor the coming reshuffles can be read off it
+void observerView(const UNOState& s, UNOState& view, UNORng& rng);
+
+// True when both states are the same position (ring slots outside the deck
+// and discard runs are scratch space and are ignored)
+bool samePosition(const UNOState& a, const UNOState& b);
+
+// The same text UNOGame::getState() prints
+std::string formatState(const UNOState& s);
+
+#endif // UNO_STATE_H
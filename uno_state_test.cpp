@@ -0,0 +1,88 @@
+#include "uno.h"
+#include <iostream>
+
+using namespace std;
+
+int main() {
+    auto game = UNOGame::create(2);
+    game->initialize();
+    cout << game->getState() << endl;
+    cout << "Live state bytes (2 players): " << game->getPosition().copyBytes()
+         << " of " << sizeof(UNOState) << endl;
+
+    // Legal plays for the current player
+    UNOMove moves[kMaxMoves];
+    int n = game->getLegalMoves(moves);
+    cout << "Legal moves:";
+    for (int i = 0; i < n; ++i) {
+        cout << " " << (moves[i].kind == UNOMove::DRAW ? "Draw" : cardName(moves[i].card));
+    }
+    cout << endl;
+
+    // makeMove followed by unmakeMove must give back the same position,
+    // whichever legal move is taken and however long the game runs
+    UNORng pick(7);
+    bool undoOk = true;
+    int steps = 0;
+    for (int g = 0; g < 200 && undoOk; ++g) {
+        auto sim = UNOGame::create(3, g);
+        sim->initialize();
+        while (!sim->isGameOver() && steps < 200000) {
+            UNOState before;
+            before.copyFrom(sim->getPosition());
+            int m = sim->getLegalMoves(moves);
+            for (int i = 0; i < m && undoOk; ++i) {
+                UNOUndo undo;
+                sim->makeMove(moves[i], undo);
+                sim->unmakeMove(undo);
+                undoOk = samePosition(before, sim->getPosition());
+            }
+            UNOUndo keep;
+            sim->makeMove(moves[pick() % m], keep);
+            ++steps;
+        }
+    }
+    cout << "make/unmake round trips over " << steps << " turns: " << (undoOk ? "ok" : "FAILED") << endl;
+
+    // A clone taken mid-game plays out exactly like the original, position
+    // and turn count checked after every step
+    bool cloneOk = true;
+    for (int g = 0; g < 200 && cloneOk; ++g) {
+        auto orig = UNOGame::create(2 + g % 4, 500 + g);
+        orig->initialize();
+        for (int t = 0; t < g % 10 && !orig->isGameOver(); ++t) orig->playTurn();
+        auto copy = orig->clone();
+        cloneOk = samePosition(orig->getPosition(), copy->getPosition()) &&
+                  orig->getStats().turns == copy->getStats().turns;
+        while (cloneOk && !orig->isGameOver() && orig->getStats().turns < 5000) {
+            orig->playTurn();
+            copy->playTurn();
+            cloneOk = samePosition(orig->getPosition(), copy->getPosition()) &&
+                      orig->getStats().turns == copy->getStats().turns &&
+                      orig->isGameOver() == copy->isGameOver();
+        }
+        cloneOk = cloneOk && orig->getWinner() == copy->getWinner();
+    }
+    cout << "Clones step in lockstep with the original: " << (cloneOk ? "ok" : "FAILED") << endl;
+
+    // Determinization keeps hand sizes, the observer's own hand and the
+    // public discard pile
+    auto fresh = UNOGame::create(4, 42);
+    fresh->initialize();
+    const UNOState& real = fresh->getPosition();
+    UNOState guess;
+    guess.copyFrom(real);
+    UNORng sampler(99);
+    determinize(guess, 0, sampler);
+    bool keptOk = guess.hands[0].present == real.hands[0].present &&
+                  guess.pile.top() == real.pile.top() &&
+                  guess.pile.getDiscardSize() == real.pile.getDiscardSize() &&
+                  guess.pile.getDeckSize() == real.pile.getDeckSize();
+    for (int p = 0; p < real.numPlayers; ++p) {
+        keptOk = keptOk && guess.hands[p].getSize() == real.hands[p].getSize();
+    }
+    cout << "Determinized: " << formatState(guess) << endl;
+    cout << "Determinization keeps what player 0 can see: " << (keptOk ? "ok" : "FAILED") << endl;
+
+    return undoOk && cloneOk && keptOk ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+// uno_strategy.cpp
+#include "uno_strategy.h"
+#include "uno_cards.h"
+
+namespace {
+
+// Smallest hand among the other players
+int smallestOpponentHand(const UNOState& s) {
+    int best = kDeckSize;
+    for (int p = 0; p < s.numPlayers; ++p) {
+        if (p != s.currentPlayer && s.hands[p].getSize() < best) best = s.hands[p].getSize();
+    }
+    return best;
+}
+
+// Legal move with the highest score; earlier moves win ties
+template <class Score>
+UNOMove bestScoring(const UNOMove legal[], int count, Score score) {
+    int best = 0, bestScore = score(legal[0]);
+    for (int i = 1; i < count; ++i) {
+        int sc = score(legal[i]);
+        if (sc > bestScore) {
+            best = i;
+            bestScore = sc;
+        }
+    }
+    return legal[best];
+}
+
+// Draw Two, then Skip / Reverse, then numbers high to low
+int aggressiveScore(const UNOMove& m) {
+    if (m.kind != UNOMove::PLAY) return -1;
+    int kind = codeKind(m.card);
+    if (kind == kKindDrawTwo) return 100;
+    if (kind > 9) return 90;
+    return kind;
+}
+
+// ------------------------------
+// Built-in strategies
+// ------------------------------
+class GreedyStrategy : public UNOStrategy {
+public:
+    std::string name() const override { return "greedy"; }
+    UNOMove chooseMove(const UNOState& s, const UNOMove[], int) override {
+        return greedyMove(s);
+    }
+};
+
+class RandomStrategy : public UNOStrategy {
+private:
+    UNORng rng;
+
+public:
+    explicit RandomStrategy(uint64_t seed) : rng(seed) {}
+    std::string name() const override { return "random"; }
+    void newGame(int seat, uint64_t gameSeed) override { rng.reseed(gameSeed, seat); }
+    UNOMove chooseMove(const UNOState&, const UNOMove legal[], int count) override {
+        return legal[rng.bounded(static_cast<uint32_t>(count))];
+    }
+};
+
+class AggressiveStrategy : public UNOStrategy {
+public:
+    std::string name() const override { return "aggressive"; }
+    UNOMove chooseMove(const UNOState&, const UNOMove legal[], int count) override {
+        return bestScoring(legal, count, aggressiveScore);
+    }
+};
+
+class ColorStrategy : public UNOStrategy {
+public:
+    std::string name() const override { return "color"; }
+    UNOMove chooseMove(const UNOState& s, const UNOMove legal[], int count) override {
+        const CardHand& hand = s.hands[s.currentPlayer];
+        int held[kCardColors];
+        for (int c = 0; c < kCardColors; ++c) held[c] = __builtin_popcountll(hand.present & colorBits(c));
+        // Land on the colour we hold most of; among those, dump actions first
+        return bestScoring(legal, count, [&held](const UNOMove& m) {
+            if (m.kind != UNOMove::PLAY) return -1;
+            return held[codeColor(m.card)] * 128 + aggressiveScore(m);
+        });
+    }
+};
+
+class SaverStrategy : public UNOStrategy {
+public:
+    std::string name() const override { return "saver"; }
+    UNOMove chooseMove(const UNOState& s, const UNOMove legal[], int count) override {
+        if (smallestOpponentHand(s) <= 2) return bestScoring(legal, count, aggressiveScore);
+        return bestScoring(legal, count, [](const UNOMove& m) {
+            if (m.kind != UNOMove::PLAY) return -1;
+            int kind = codeKind(m.card);
+            return kind <= 9 ? 100 + kind : kind;
+        });
+    }
+};
+
+} // namespace
+
+// Factory method
+std::unique_ptr<UNOStrategy> UNOStrategy::create(const std::string& name, uint64_t seed) {
+    if (name == "greedy") return std::unique_ptr<UNOStrategy>(new GreedyStrategy());
+    if (name == "random") return std::unique_ptr<UNOStrategy>(new RandomStrategy(seed));
+    if (name == "aggressive") return std::unique_ptr<UNOStrategy>(new AggressiveStrategy());
+    if (name == "color") return std::unique_ptr<UNOStrategy>(new ColorStrategy());
+    if (name == "saver") return std::unique_ptr<UNOStrategy>(new SaverStrategy());
+    return nullptr;
+}
+
+std::vector<std::string> UNOStrategy::builtinNames() {
+    return { "greedy", "random", "aggressive", "color", "saver" };
+}
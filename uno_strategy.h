@@ -0,0 +1,43 @@
+#ifndef UNO_STRATEGY_H
+#define UNO_STRATEGY_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "uno_state.h"
+
+// ------------------------------
+// Abstract play policy
+// ------------------------------
+// Decides the move for whoever is to play in a position. The state handed
+// over is an observerView(): the mover's own hand, the hand sizes and the
+// discards are real, the other hands and the deck order are a random
+// resample. A move that is not one of legal[0..count) is replaced by the
+// built-in greedy move.
+class UNOStrategy {
+public:
+    virtual ~UNOStrategy() = default;
+
+    virtual std::string name() const = 0;
+
+    // Called before each game with the seat played and a per-game seed, so a
+    // randomised strategy plays the same game the same way wherever it runs
+    virtual void newGame(int /*seat*/, uint64_t /*gameSeed*/) {}
+
+    // Pick one of legal[0..count), as filled in by legalMoves(): the playable
+    // cards, or a single DRAW when nothing is playable
+    virtual UNOMove chooseMove(const UNOState& s, const UNOMove legal[], int count) = 0;
+
+    // Factory method (implemented in .cpp). Built-in names:
+    //   greedy     - the original policy: same colour first, oldest card first
+    //   random     - any legal move, uniformly
+    //   aggressive - Draw Two, then Skip / Reverse, then the highest number
+    //   color      - keep to the colour held most, change colour with a match by number
+    //   saver      - hold action cards back until the opponent is down to two cards
+    // Returns nullptr for an unknown name.
+    static std::unique_ptr<UNOStrategy> create(const std::string& name, uint64_t seed = 0);
+    static std::vector<std::string> builtinNames();
+};
+
+#endif // UNO_STRATEGY_H
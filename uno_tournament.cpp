@@ -0,0 +1,310 @@
+// uno_tournament.cpp
+#include "uno_tournament.h"
+#include "uno.h"
+#include "uno_strategy.h"
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <memory>
+#include <map>
+
+namespace {
+
+// Play one two-player game through UNOGame, so deals and strategy seeding
+// are exactly what a hand-built game gets; returns the winning seat, or -1
+// if unfinished
+int playGame(UNOStrategy* seat0, UNOStrategy* seat1, uint64_t seed, uint64_t stream, int maxTurns) {
+    auto game = UNOGame::create(2, seed, stream);
+    game->setStrategy(0, seat0);
+    game->setStrategy(1, seat1);
+    game->initialize();
+    while (!game->isGameOver() && game->getStats().turns < maxTurns) game->playTurn();
+    return game->getWinner();
+}
+
+// No verdict before this many deals. The half-deal prior in dealMoments
+// already keeps the variance honest, so this only stops a handful of
+// lopsided opening deals from ending a pair.
+const uint64_t kMinDeals = 16;
+
+// One seat-swapped deal as the workers report it
+struct DealResult {
+    uint8_t bucket;          // A's pair score in quarters
+    uint8_t winsA, winsB;
+};
+
+// Pair score for the test: A's mean over both games of a deal
+double dealScore(int bucket) { return bucket / 4.0; }
+
+// Mean and variance of the pair scores, with half a virtual deal in every
+// bucket so the first few (often identical) deals can't give a zero variance
+void dealMoments(const uint64_t deals[5], double& count, double& mean, double& var) {
+    count = 0;
+    double sum = 0;
+    for (int i = 0; i < 5; ++i) {
+        count += deals[i] + 0.5;
+        sum += (deals[i] + 0.5) * dealScore(i);
+    }
+    mean = sum / count;
+    var = 0;
+    for (int i = 0; i < 5; ++i) var += (deals[i] + 0.5) * (dealScore(i) - mean) * (dealScore(i) - mean);
+    var /= count;
+}
+
+// z with P(Z <= z) = p for a standard normal, by bisection
+double normalQuantile(double p) {
+    double lo = -10, hi = 10;
+    for (int i = 0; i < 100; ++i) {
+        double mid = 0.5 * (lo + hi);
+        if (0.5 * std::erfc(-mid / std::sqrt(2.0)) < p) lo = mid;
+        else hi = mid;
+    }
+    return 0.5 * (lo + hi);
+}
+
+// ------------------------------
+// SPRT pair scheduler
+// ------------------------------
+// Hands out batches of games to the workers, always from the undecided pair
+// with the fewest games handed out so far. Finished batches are folded back
+// in deal order, whatever order the workers finish them in, and the test is
+// run after every deal, so a pair stops at the first deal whose LLR crosses
+// a bound - the same deal on any thread count. Deals played past that point
+// (the rest of the batch, or batches still in flight) are discarded.
+class Scheduler {
+public:
+    Scheduler(const UNOTournamentConfig& cfg, std::vector<UNOPairResult>& pairs)
+        : pairs(pairs),
+          claimed(pairs.size(), 0),
+          folded(pairs.size(), 0),
+          waiting(pairs.size()),
+          decided(pairs.size(), false),
+          discarded(0),
+          maxGames(std::max<uint64_t>(2, cfg.maxGamesPerPair & ~1ULL)),
+          batch(std::max(2, cfg.batchGames & ~1))
+    {
+        // Expected score of the stronger side at the margin, as on the Elo scale
+        double p1 = 1.0 / (1.0 + std::pow(10.0, -cfg.eloMargin / 400.0));
+        score0 = 1.0 - p1;
+        score1 = p1;
+        lower = std::log(cfg.beta / (1.0 - cfg.alpha));
+        upper = std::log((1.0 - cfg.beta) / cfg.alpha);
+    }
+
+    bool claim(int& pair, uint64_t& first, int& count) {
+        std::lock_guard<std::mutex> guard(lock);
+        int best = -1;
+        for (size_t i = 0; i < pairs.size(); ++i) {
+            if (decided[i] || claimed[i] >= maxGames) continue;
+            if (best < 0 || claimed[i] < claimed[best]) best = static_cast<int>(i);
+        }
+        if (best < 0) return false;
+        pair = best;
+        first = claimed[best];
+        count = static_cast<int>(std::min<uint64_t>(batch, maxGames - first));
+        claimed[best] += count;
+        return true;
+    }
+
+    void finish(int pair, uint64_t first, std::vector<DealResult>& deals) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (decided[pair]) {
+            discarded += 2 * deals.size();
+            return;
+        }
+        waiting[pair][first].swap(deals);
+        std::map<uint64_t, std::vector<DealResult>>& queue = waiting[pair];
+        while (!queue.empty() && queue.begin()->first == folded[pair] && !decided[pair]) {
+            const std::vector<DealResult>& next = queue.begin()->second;
+            folded[pair] += 2 * next.size();
+            for (size_t i = 0; i < next.size(); ++i) {
+                if (decided[pair]) {
+                    discarded += 2 * (next.size() - i);
+                    break;
+                }
+                fold(pair, next[i]);
+            }
+            queue.erase(queue.begin());
+        }
+        if (decided[pair]) {
+            for (const auto& later : queue) discarded += 2 * later.second.size();
+            queue.clear();
+        }
+    }
+
+    uint64_t discardedGames() const { return discarded; }
+
+private:
+    // Add one deal and test the bounds
+    void fold(int pair, const DealResult& d) {
+        UNOPairResult& r = pairs[pair];
+        r.games += 2;
+        r.winsA += d.winsA;
+        r.winsB += d.winsB;
+        r.deals[d.bucket]++;
+        // Normal-approximation LLR of H1 (mean score1) over H0 (mean score0)
+        double count, mean, var;
+        dealMoments(r.deals, count, mean, var);
+        r.llr = count * (score1 - score0) * (2 * mean - score0 - score1) / (2 * var);
+        if (r.games / 2 < kMinDeals) return;
+        if (r.llr >= upper) r.verdict = 1;
+        else if (r.llr <= lower) r.verdict = -1;
+        decided[pair] = r.verdict != 0;
+    }
+
+    std::mutex lock;
+    std::vector<UNOPairResult>& pairs;
+    std::vector<uint64_t> claimed;
+    std::vector<uint64_t> folded;    // games folded in, in deal order
+    std::vector<std::map<uint64_t, std::vector<DealResult>>> waiting;  // finished early, by first game
+    std::vector<bool> decided;
+    uint64_t discarded;
+    uint64_t maxGames;
+    int batch;
+    double score0, score1, lower, upper;
+};
+
+void workerLoop(const UNOTournamentConfig& cfg, const std::vector<std::string>& names,
+                const std::vector<UNOPairResult>& pairs, Scheduler& scheduler) {
+    // Each worker has its own strategy objects, so stateful ones never share
+    std::vector<std::unique_ptr<UNOStrategy>> own;
+    for (const std::string& n : names) own.push_back(UNOStrategy::create(n, cfg.baseSeed));
+
+    int pair, count;
+    uint64_t first;
+    std::vector<DealResult> deals;
+    while (scheduler.claim(pair, first, count)) {
+        UNOStrategy* a = own[pairs[pair].a].get();
+        UNOStrategy* b = own[pairs[pair].b].get();
+        deals.clear();
+        for (int i = 0; i < count; i += 2) {
+            // Games 2k and 2k+1 share deal k with the seats swapped; batches
+            // are even and start on an even game, so both land here
+            uint64_t stream = (static_cast<uint64_t>(pair) << 32) | ((first + i) / 2);
+            int first0 = playGame(a, b, cfg.baseSeed, stream, cfg.maxTurns);   // a in seat 0
+            int first1 = playGame(b, a, cfg.baseSeed, stream, cfg.maxTurns);   // a in seat 1
+            DealResult d = { 2, 0, 0 };   // A's score in quarters, unfinished games counting half
+            if (first0 >= 0) {
+                d.bucket += first0 == 0 ? 1 : -1;
+                (first0 == 0 ? d.winsA : d.winsB)++;
+            }
+            if (first1 >= 0) {
+                d.bucket += first1 == 1 ? 1 : -1;
+                (first1 == 1 ? d.winsA : d.winsB)++;
+            }
+            deals.push_back(d);
+        }
+        scheduler.finish(pair, first, deals);
+    }
+}
+
+} // namespace
+
+double UNOPairResult::scoreA() const {
+    uint64_t finished = winsA + winsB;
+    return finished ? static_cast<double>(winsA) / finished : 0.5;
+}
+
+UNOTournamentResults UNOTournament::run(const UNOTournamentConfig& cfg) {
+    UNOTournamentResults res;
+    for (const std::string& n : cfg.strategies) {
+        if (UNOStrategy::create(n)) res.names.push_back(n);
+    }
+    int count = static_cast<int>(res.names.size());
+    for (int a = 0; a < count; ++a) {
+        for (int b = a + 1; b < count; ++b) {
+            UNOPairResult r;
+            r.a = a;
+            r.b = b;
+            r.games = r.winsA = r.winsB = 0;
+            for (int i = 0; i < 5; ++i) r.deals[i] = 0;
+            r.llr = 0;
+            r.verdict = 0;
+            res.pairs.push_back(r);
+        }
+    }
+
+    int threads = cfg.numThreads > 0 ? cfg.numThreads
+                                     : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(1, threads);
+
+    auto start = std::chrono::steady_clock::now();
+    Scheduler scheduler(cfg, res.pairs);
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) {
+        pool.emplace_back(workerLoop, std::cref(cfg), std::cref(res.names),
+                          std::cref(res.pairs), std::ref(scheduler));
+    }
+    for (std::thread& th : pool) th.join();
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    res.threadsUsed = threads;
+    res.discardedGames = scheduler.discardedGames();
+
+    // Aggregate per strategy and rank
+    std::vector<uint64_t> won(count, 0), finished(count, 0);
+    res.pairsWon.assign(count, 0);
+    res.totalGames = 0;
+    for (const UNOPairResult& r : res.pairs) {
+        res.totalGames += r.games;
+        won[r.a] += r.winsA;
+        won[r.b] += r.winsB;
+        finished[r.a] += r.winsA + r.winsB;
+        finished[r.b] += r.winsA + r.winsB;
+        if (r.verdict > 0) res.pairsWon[r.a]++;
+        if (r.verdict < 0) res.pairsWon[r.b]++;
+    }
+    res.score.resize(count);
+    for (int i = 0; i < count; ++i) {
+        res.score[i] = finished[i] ? static_cast<double>(won[i]) / finished[i] : 0.5;
+        res.ranking.push_back(i);
+    }
+    std::stable_sort(res.ranking.begin(), res.ranking.end(), [&res](int x, int y) {
+        if (res.pairsWon[x] != res.pairsWon[y]) return res.pairsWon[x] > res.pairsWon[y];
+        return res.score[x] > res.score[y];
+    });
+
+    // Fixed-count baseline with the same power: a one-shot test of the mean
+    // pair score needs ((z_alpha + z_beta) * sigma / (score1 - score0))^2
+    // deals to hold both error rates, sigma from the variance of all pairs
+    double p1 = 1.0 / (1.0 + std::pow(10.0, -cfg.eloMargin / 400.0));
+    double spread = 2 * p1 - 1;
+    double pooled = 0, weight = 0;
+    for (const UNOPairResult& r : res.pairs) {
+        double n, mean, var;
+        dealMoments(r.deals, n, mean, var);
+        pooled += n * var;
+        weight += n;
+    }
+    double z = normalQuantile(1 - cfg.alpha) + normalQuantile(1 - cfg.beta);
+    double dealsPerPair = weight > 0 ? std::ceil(z * z * (pooled / weight) / (spread * spread)) : 0;
+    res.fixedGames = res.pairs.size() * 2 * static_cast<uint64_t>(dealsPerPair);
+    return res;
+}
+
+std::string UNOTournamentResults::report() const {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "Pairs:\n";
+    for (const UNOPairResult& r : pairs) {
+        ss << "  " << std::setw(10) << names[r.a] << " vs " << std::left << std::setw(10) << names[r.b]
+           << std::right << " games " << std::setw(6) << r.games << ", score " << r.scoreA()
+           << ", LLR " << std::setw(7) << std::setprecision(2) << r.llr << std::setprecision(3) << ", "
+           << (r.verdict > 0 ? names[r.a] + " stronger"
+               : r.verdict < 0 ? names[r.b] + " stronger" : std::string("undecided")) << "\n";
+    }
+    ss << "Ranking:\n";
+    for (size_t i = 0; i < ranking.size(); ++i) {
+        int s = ranking[i];
+        ss << "  " << i + 1 << ". " << std::left << std::setw(10) << names[s] << std::right
+           << " pairs won " << pairsWon[s] << ", score " << score[s] << "\n";
+    }
+    ss << std::setprecision(1) << "Games: " << totalGames << " (a fixed count with the same power would be "
+       << fixedGames << ", " << (totalGames ? static_cast<double>(fixedGames) / totalGames : 0.0) << "x; "
+       << discardedGames << " more were played past a verdict and discarded), "
+       << "Threads: " << threadsUsed << ", " << std::setprecision(2) << seconds << " s";
+    return ss.str();
+}
@@ -0,0 +1,84 @@
+#ifndef UNO_TOURNAMENT_H
+#define UNO_TOURNAMENT_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// ------------------------------
+// Tournament settings
+// ------------------------------
+// Every pair of strategies plays two-player games until a sequential
+// probability ratio test (SPRT) decides which of the two is stronger, or
+// until maxGamesPerPair. The test is H0 "A is eloMargin weaker than B"
+// against H1 "A is eloMargin stronger", with error rates alpha and beta;
+// pairs closer than the margin can be decided either way.
+//
+// Games come in seat-swapped pairs on one deal, and the two results are
+// correlated, so the test's observation is the pair: A's mean score over
+// both games (0, 1/4, ... 1 with unfinished games scoring 1/2). The log
+// likelihood ratio is the normal approximation over those pair scores, with
+// their variance measured as the pair goes (a generalised SPRT). The bounds
+// are tested after every deal, in deal order; no pair is decided before 16
+// deals.
+struct UNOTournamentConfig {
+    std::vector<std::string> strategies;  // names for UNOStrategy::create (unknown names are dropped)
+    uint64_t baseSeed;
+    int numThreads;            // 0 = one per hardware thread
+    int maxTurns;              // longer games count as unfinished (no winner)
+    double eloMargin;
+    double alpha, beta;
+    uint64_t maxGamesPerPair;  // rounded down to an even number
+    int batchGames;            // games per work unit (even: whole seat-swapped pairs); only
+                               // bounds the games discarded past a verdict, not where it falls
+
+    UNOTournamentConfig()
+        : baseSeed(1234), numThreads(0), maxTurns(5000), eloMargin(20),
+          alpha(0.05), beta(0.05), maxGamesPerPair(20000), batchGames(16) {}
+};
+
+// ------------------------------
+// One pairing
+// ------------------------------
+struct UNOPairResult {
+    int a, b;                  // indices into UNOTournamentResults::names
+    uint64_t games;
+    uint64_t winsA, winsB;     // the rest were unfinished
+    uint64_t deals[5];         // seat-swapped deals by A's pair score 0, 1/4, 1/2, 3/4, 1
+    double llr;                // log-likelihood ratio of H1 over H0
+    int verdict;               // +1 a is stronger, -1 b is stronger, 0 undecided
+
+    double scoreA() const;     // share of finished games won by a
+};
+
+// ------------------------------
+// Tournament results
+// ------------------------------
+struct UNOTournamentResults {
+    std::vector<std::string> names;
+    std::vector<UNOPairResult> pairs;
+    std::vector<int> ranking;      // strategy indices, best first
+    std::vector<int> pairsWon;     // SPRT verdicts won, per strategy
+    std::vector<double> score;     // share of finished games won, per strategy
+    uint64_t totalGames;           // games the tests used
+    uint64_t discardedGames;       // played past a pair's verdict and not counted
+    uint64_t fixedGames;           // games a fixed-count test with the same alpha, beta and
+                                   // hypotheses would need, from the measured pair-score variance
+    int threadsUsed;
+    double seconds;
+
+    std::string report() const;
+};
+
+// ------------------------------
+// Multi-threaded SPRT tournament
+// ------------------------------
+class UNOTournament {
+public:
+    // Ranked by SPRT verdicts won, then by score. Each game's deal and
+    // play are fixed by its seed, and deals are tested in order, so the
+    // results don't depend on the thread count (only discardedGames does).
+    static UNOTournamentResults run(const UNOTournamentConfig& cfg);
+};
+
+#endif // UNO_TOURNAMENT_H
@@ -0,0 +1,85 @@
+#include "uno.h"
+#include "uno_strategy.h"
+#include "uno_tournament.h"
+#include <iostream>
+
+using namespace std;
+
+// A broken plug-in: always plays the first card it can't see in its own hand
+class CheatingStrategy : public UNOStrategy {
+public:
+    std::string name() const override { return "cheat"; }
+    UNOMove chooseMove(const UNOState& s, const UNOMove[], int) override {
+        uint64_t missing = ~s.hands[s.currentPlayer].present & 0x1FFF;
+        return UNOMove::play(static_cast<CardCode>(__builtin_ctzll(missing | (1ULL << 12))));
+    }
+};
+
+// Remembers the seed newGame() hands it
+class SeedProbe : public UNOStrategy {
+public:
+    uint64_t seed = 0;
+    std::string name() const override { return "probe"; }
+    void newGame(int, uint64_t gameSeed) override { seed = gameSeed; }
+    UNOMove chooseMove(const UNOState& s, const UNOMove[], int) override { return greedyMove(s); }
+};
+
+int main() {
+    // Per-seat strategies in a single game
+    auto aggressive = UNOStrategy::create("aggressive");
+    auto saver = UNOStrategy::create("saver");
+    auto game = UNOGame::create(3, 42);
+    game->setStrategy(0, aggressive.get());
+    game->setStrategy(2, saver.get());  // seat 1 keeps the built-in greedy policy
+    game->initialize();
+    while (!game->isGameOver()) game->playTurn();
+    cout << "aggressive / greedy / saver: Player " << game->getWinner() << " wins after "
+         << game->getStats().turns << " turns" << endl << endl;
+
+    // Illegal moves are replaced by the greedy move, so cards stay conserved
+    CheatingStrategy cheat;
+    auto guarded = UNOGame::create(2, 7);
+    guarded->setStrategy(0, &cheat);
+    guarded->initialize();
+    bool conserved = true;
+    while (!guarded->isGameOver() && guarded->getStats().turns < 5000) {
+        guarded->playTurn();
+        const UNOState& st = guarded->getPosition();
+        int cards = st.pile.getDeckSize() + st.pile.getDiscardSize();
+        for (int p = 0; p < st.numPlayers; ++p) cards += st.hands[p].getSize();
+        conserved = conserved && cards == kDeckSize;
+    }
+    cout << "Illegal plug-in moves rejected: " << (conserved ? "ok" : "FAILED") << endl << endl;
+
+    // A strategy's seed is none of the outputs the deal will draw
+    SeedProbe probe;
+    bool seedHidden = true;
+    for (uint64_t stream = 0; stream < 100 && seedHidden; ++stream) {
+        auto seeded = UNOGame::create(2, 99, stream);
+        seeded->setStrategy(0, &probe);
+        seeded->initialize();
+        UNORng deal(99, stream);
+        for (int i = 0; i < 1000; ++i) seedHidden = seedHidden && deal() != probe.seed;
+    }
+    cout << "Strategy seeds independent of the deal: " << (seedHidden ? "ok" : "FAILED") << endl << endl;
+
+    // Round robin of every built-in strategy
+    UNOTournamentConfig cfg;
+    cfg.strategies = UNOStrategy::builtinNames();
+    cfg.numThreads = 1;
+    UNOTournamentResults res = UNOTournament::run(cfg);
+    cout << res.report() << endl;
+
+    // Deals are tested in order, so every pair stops on the same deal
+    // whatever the thread count
+    cfg.numThreads = 8;
+    UNOTournamentResults wide = UNOTournament::run(cfg);
+    bool sameStops = wide.pairs.size() == res.pairs.size();
+    for (size_t i = 0; i < res.pairs.size() && sameStops; ++i) {
+        const UNOPairResult& x = res.pairs[i];
+        const UNOPairResult& y = wide.pairs[i];
+        sameStops = x.games == y.games && x.winsA == y.winsA && x.winsB == y.winsB && x.verdict == y.verdict;
+    }
+    cout << "Same verdicts and stopping deals on 1 and 8 threads: " << (sameStops ? "ok" : "FAILED") << endl;
+    return conserved && seedHidden && sameStops ? 0 : 1;
+}